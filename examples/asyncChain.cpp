@@ -0,0 +1,89 @@
+/**
+ * @file asyncChain.cpp
+ * @author Люнгрин Андрей aka prostoichelovek <iam.prostoi.chelovek@gmail.ru>
+ * @date 19 Oct 2026
+ * @copyright MIT License
+ *
+ * @brief This file contains an example of chaining the asynchronous calls of the components,
+ *        so decoding of the next frames overlaps with processing of the previous ones
+ *
+ * Usage: faces_asyncChain <video> [frames in flight]
+ */
+
+#include <deque>
+
+#include <spdlog/sinks/stdout_color_sinks.h>
+
+#include <Config/Config.h>
+#include <Detector/Implementations/OcvDefaultDnnDetector.h>
+#include <Landmarker/Implementations/DlibLandmarker.h>
+#include <Aligner/Implementations/DlibChipAligner.h>
+#include <QualityEstimator/Implementations/HeuristicQualityEstimator.h>
+#include <Recognizer/Implementations/Descriptors/DlibResnetSvmRecognizer.h>
+
+int main(int argc, char **argv) {
+    auto console = spdlog::stdout_color_mt("console", spdlog::color_mode::always);
+    spdlog::set_default_logger(console);
+
+    if (argc < 2) {
+        spdlog::error("Usage: {} <video> [frames in flight]", argv[0]);
+        return 1;
+    }
+    std::size_t inFlight = argc > 2 ? std::stoul(argv[2]) : 4;
+
+    faces::Config &configInstance = faces::Config::getInstance();
+    std::string configFile = FACES_ROOT_DIRECTORY "/config.json";
+    if (!configInstance.config.config(configFile)) {
+        spdlog::error("Cannot load a config from the file '{}'", configFile);
+        return 1;
+    }
+
+    std::unique_ptr<faces::Detector> detector(FACES_CREATE_INSTANCE(Detector, OcvDefaultDnn, configInstance));
+    std::unique_ptr<faces::Landmarker> landmarker(FACES_CREATE_INSTANCE(Landmarker, Dlib, configInstance));
+    std::unique_ptr<faces::Aligner> aligner(FACES_CREATE_INSTANCE(Aligner, DlibChip, configInstance));
+    std::unique_ptr<faces::QualityEstimator> qualityEstimator(FACES_CREATE_INSTANCE(QualityEstimator, Heuristic,
+                                                                                    configInstance));
+    std::unique_ptr<faces::Recognizer> recognizer(FACES_CREATE_INSTANCE(Recognizer, DlibResnetSvm, configInstance));
+    if (!detector || !detector->isOk() || !landmarker || !landmarker->isOk() || !aligner || !aligner->isOk()
+        || !qualityEstimator || !qualityEstimator->isOk() || !recognizer || !recognizer->isOk()) {
+        spdlog::error("Cannot load some component!");
+        return 1;
+    }
+
+    // each of the components processes one frame at a time, but different frames are at different stages
+    std::deque<faces::Future<std::vector<faces::Face>>> results;
+    auto takeResult = [&results]() {
+        std::vector<faces::Face> faces = results.front().get();
+        results.pop_front();
+        for (faces::Face const &face : faces) {
+            spdlog::info("{} at ({}, {})", face.label, face.rect.x, face.rect.y);
+        }
+    };
+
+    cv::VideoCapture cap(argv[1]);
+    for (cv::Mat frame; cap.read(frame); frame = cv::Mat()) {
+        results.emplace_back(
+                detector->detectAsync(frame)
+                        .then([&landmarker](std::vector<faces::Face> faces) {
+                            return landmarker->detectAsync(std::move(faces));
+                        })
+                        .then([&aligner, frame](std::vector<faces::Face> faces) {
+                            return aligner->alignAsync(std::move(faces), frame);
+                        })
+                        .then([&qualityEstimator](std::vector<faces::Face> faces) {
+                            return qualityEstimator->estimateAsync(std::move(faces));
+                        })
+                        .then([&recognizer](std::vector<faces::Face> faces) {
+                            return recognizer->recognizeAsync(std::move(faces));
+                        }));
+
+        if (results.size() >= inFlight) {
+            takeResult();
+        }
+    }
+    while (!results.empty()) {
+        takeResult();
+    }
+
+    return 0;
+}
@@ -0,0 +1,85 @@
+/**
+ * @file decimationBenchmark.cpp
+ * @author Люнгрин Андрей aka prostoichelovek <iam.prostoi.chelovek@gmail.ru>
+ * @date 19 Oct 2026
+ * @copyright MIT License
+ *
+ * @brief This file contains a measurement of the indexing throughput (seconds of a video per second)
+ *        at several decimation factors of the frame source
+ *
+ * Usage: faces_decimationBenchmark <video> [detect: 0 or 1] [decimation factors...]
+ */
+
+#include <chrono>
+
+#include <spdlog/sinks/stdout_color_sinks.h>
+
+#include <Config/Config.h>
+#include <Detector/Implementations/OcvDefaultDnnDetector.h>
+#include <FrameSource/Implementations/VideoFrameSource.h>
+
+int main(int argc, char **argv) {
+    auto console = spdlog::stdout_color_mt("console", spdlog::color_mode::always);
+    spdlog::set_default_logger(console);
+
+    if (argc < 2) {
+        spdlog::error("Usage: {} <video> [detect: 0 or 1] [decimation factors...]", argv[0]);
+        return 1;
+    }
+    bool shouldDetect = argc > 2 && std::stoi(argv[2]) != 0;
+    std::vector<std::size_t> factors;
+    for (int i = 3; i < argc; ++i) {
+        factors.emplace_back(std::stoul(argv[i]));
+    }
+    if (factors.empty()) {
+        factors = {1, 2, 5, 10, 25};
+    }
+
+    faces::Config &configInstance = faces::Config::getInstance();
+    std::string configFile = FACES_ROOT_DIRECTORY "/config.json";
+    if (!configInstance.config.config(configFile)) {
+        spdlog::error("Cannot load a config from the file '{}'", configFile);
+        return 1;
+    }
+
+    std::unique_ptr<faces::Detector> detector;
+    if (shouldDetect) {
+        detector.reset(FACES_CREATE_INSTANCE(Detector, OcvDefaultDnn, configInstance));
+        if (!detector || !detector->isOk()) {
+            spdlog::error("Cannot load the detector!");
+            return 1;
+        }
+    }
+
+    for (std::size_t factor : factors) {
+        auto start = std::chrono::steady_clock::now();
+
+        faces::VideoFrameSource source(argv[1], configInstance);
+        if (!source.isOk()) {
+            return 1;
+        }
+        // the frames decoded ahead before the decimation is set are discarded by the seek
+        source.setDecimation(factor);
+        source.seek(0);
+
+        std::size_t analyzed = 0, facesCount = 0;
+        double videoTime = 0;
+        faces::FrameSource::Handle handle;
+        while (source.next(handle)) {
+            if (detector) {
+                facesCount += detector->detect(handle->img).size();
+            }
+            videoTime = handle->timestamp;
+            ++analyzed;
+            source.release(handle);
+        }
+
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        spdlog::info("Decimation {:>3}: {} frames analyzed, {} faces, {:.1f} s of video in {:.2f} s, "
+                     "{:.1f} video-seconds per second",
+                     factor, analyzed, facesCount,
+                     videoTime / 1000, elapsed.count(), videoTime / 1000 / elapsed.count());
+    }
+
+    return 0;
+}
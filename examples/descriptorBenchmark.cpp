@@ -0,0 +1,96 @@
+/**
+ * @file descriptorBenchmark.cpp
+ * @author Люнгрин Андрей aka prostoichelovek <iam.prostoi.chelovek@gmail.ru>
+ * @date 19 Oct 2026
+ * @copyright MIT License
+ *
+ * @brief This file contains a throughput comparison of the face descriptors on the same set of chips
+ *
+ * Usage: faces_descriptorBenchmark <chips directory> [iterations] [batch size]
+ */
+
+#include <chrono>
+
+#include <spdlog/sinks/stdout_color_sinks.h>
+
+#include <Config/Config.h>
+#include <Recognizer/Implementations/Descriptors/DlibResnetDescriptor.h>
+#include <Recognizer/Implementations/Descriptors/OcvDnnDescriptor.h>
+
+/**
+ * Computes descriptors of all of the chips `iterations` times in batches of the given size
+ *
+ * @return a number of chips processed per second
+ */
+double benchmark(faces::Descriptor &descriptor, std::vector<cv::Mat> const &chips,
+                 int iterations, std::size_t batchSize) {
+    // warm up
+    descriptor.computeDescriptors(chips.front());
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        for (std::size_t begin = 0; begin < chips.size(); begin += batchSize) {
+            std::size_t end = std::min(begin + batchSize, chips.size());
+            if (batchSize == 1) {
+                descriptor.computeDescriptors(chips[begin]);
+            } else {
+                descriptor.computeDescriptors(std::vector<cv::Mat>(chips.begin() + begin, chips.begin() + end));
+            }
+        }
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    return static_cast<double>(chips.size()) * iterations / elapsed.count();
+}
+
+int main(int argc, char **argv) {
+    auto console = spdlog::stdout_color_mt("console", spdlog::color_mode::always);
+    spdlog::set_default_logger(console);
+
+    if (argc < 2) {
+        spdlog::error("Usage: {} <chips directory> [iterations] [batch size]", argv[0]);
+        return 1;
+    }
+    int iterations = argc > 2 ? std::stoi(argv[2]) : 10;
+    std::size_t batchSize = argc > 3 ? std::stoul(argv[3]) : 16;
+
+    faces::Config &configInstance = faces::Config::getInstance();
+    std::string configFile = FACES_ROOT_DIRECTORY "/config.json";
+    if (!configInstance.config.config(configFile)) {
+        spdlog::error("Cannot load a config from the file '{}'", configFile);
+        return 1;
+    }
+
+    std::vector<cv::String> files;
+    cv::glob(argv[1], files);
+    std::vector<cv::Mat> chips;
+    for (cv::String const &file : files) {
+        cv::Mat chip = cv::imread(file);
+        if (!chip.empty()) {
+            chips.emplace_back(chip);
+        }
+    }
+    if (chips.empty()) {
+        spdlog::error("There are no images in '{}'", argv[1]);
+        return 1;
+    }
+
+    std::map<std::string, std::unique_ptr<faces::Descriptor>> descriptors;
+    descriptors["DlibResnet"].reset(FACES_CREATE_INSTANCE(Descriptor, DlibResnet, configInstance));
+    descriptors["OcvDnn"].reset(FACES_CREATE_INSTANCE(Descriptor, OcvDnn, configInstance));
+
+    spdlog::info("{} chips, {} iterations", chips.size(), iterations);
+    for (auto &[name, descriptor] : descriptors) {
+        if (!descriptor || !descriptor->isOk()) {
+            spdlog::warn("{}: cannot be loaded, skipping", name);
+            continue;
+        }
+
+        double single = benchmark(*descriptor, chips, iterations, 1);
+        double batched = benchmark(*descriptor, chips, iterations, batchSize);
+        spdlog::info("{} ({}-d): {:.1f} chips/s one by one, {:.1f} chips/s in batches of {}",
+                     name, descriptor->getDimension(), single, batched, batchSize);
+    }
+
+    return 0;
+}
@@ -17,15 +17,23 @@
 #include <Detector/Implementations/OcvDefaultDnnDetector.h>
 #include <Landmarker/Implementations/DlibLandmarker.h>
 #include <Aligner/Implementations/DlibChipAligner.h>
+#include <QualityEstimator/Implementations/HeuristicQualityEstimator.h>
 #include <Recognizer/Implementations/Descriptors/DlibResnetSvmRecognizer.h>
-#include <Tracker/Implementations/CentroidTracker.h>
+#include <Recognizer/TrackedRecognizer.h>
+#include <Recognizer/LostTrackMemory.h>
+#include <Tracker/Implementations/OpticalFlowTracker.h>
+#include <Tracker/TrackManager.h>
 #include <Database/DatabaseEntry.hpp>
 #include <Database/Implementations/StandaloneDatabase.hpp>
+#include <FrameSource/Implementations/VideoFrameSource.h>
 
 namespace faces {
     FACES_AUGMENT_CONFIG(test,
                          FACES_ADD_CONFIG_OPTION("testVideo", "video", "", false,
-                                                 "A video for testing"))
+                                                 "A video for testing")
+                                 FACES_ADD_CONFIG_OPTION("detectionInterval", "detectionInterval", 1, false,
+                                                         "Run the detector on every N-th frame, "
+                                                         "propagating faces by the tracker in between"))
 }
 
 class FaceInfo : public faces::DatabaseEntry<FaceInfo> {
@@ -100,35 +108,65 @@ int main(int argc, char **argv) {
     faces::Detector *detector = FACES_CREATE_INSTANCE(Detector, OcvDefaultDnn, configInstance);
     faces::Landmarker *landmarker = FACES_CREATE_INSTANCE(Landmarker, Dlib, configInstance);
     faces::Aligner *aligner = FACES_CREATE_INSTANCE(Aligner, DlibChip, configInstance);
+    faces::QualityEstimator *qualityEstimator = FACES_CREATE_INSTANCE(QualityEstimator, Heuristic,
+                                                                      configInstance);
     faces::Recognizer *recognizer = FACES_CREATE_INSTANCE(Recognizer, DlibResnetSvm, configInstance);
-    faces::Tracker *tracker = FACES_CREATE_INSTANCE(Tracker, Centroid, configInstance);
+    faces::Tracker *tracker = FACES_CREATE_INSTANCE(Tracker, OpticalFlow, configInstance);
 
     if (detector == nullptr || recognizer == nullptr || landmarker == nullptr || aligner == nullptr
-        || tracker == nullptr) {
+        || qualityEstimator == nullptr || tracker == nullptr) {
         spdlog::error("Cannot initialize some component!");
         return 1;
     }
     if (!detector->isOk() || !recognizer->isOk() || !landmarker->isOk() || !aligner->isOk()
-        || !tracker->isOk()) {
+        || !qualityEstimator->isOk() || !tracker->isOk()) {
         spdlog::error("Cannot load something!");
         return 1;
     }
 
-    cv::VideoCapture cap(configInstance.getDataPath("testVideo"));
-    cv::Mat test, prevTest;
-    std::vector<faces::Face> detected, prevDetected;
-    std::vector<std::pair<int, int>> tracked;
-
-    while (cap.isOpened()) {
-        cap >> test;
+    faces::TrackedRecognizer trackedRecognizer(recognizer, configInstance);
+
+    faces::TrackManager tracks(tracker, configInstance);
+    tracks.onBirth([](faces::TrackInfo const &track) {
+        spdlog::info("Track {:#x} appeared", track.id);
+    });
+    tracks.onDeath([](faces::TrackInfo const &track) {
+        spdlog::info("Track {:#x} with label {} disappeared after {} frames", track.id, track.label, track.age);
+    });
+
+    // the new tracks are matched with the recently lost ones using the descriptors of the recognizer
+    faces::LostTrackMemory lostTracks(dynamic_cast<faces::DescriptorsRecognizer *>(recognizer), configInstance);
+    lostTracks.watch(tracks);
+    trackedRecognizer.setLostTrackMemory(&lostTracks);
+
+    int detectionInterval = std::max(1, config["detectionInterval"].getInt());
+
+    // the frames are decoded ahead on a separate thread while the previous ones are processed
+    faces::VideoFrameSource source(configInstance.getDataPath("testVideo"), configInstance);
+    faces::FrameSource::Handle handle;
+    cv::Mat test;
+    std::vector<faces::Face> detected;
+
+    while (source.next(handle)) {
+        cv::Mat const &frame = handle->img;
+
+        // between the detections the faces are propagated by the tracker, if it can predict them
+        bool isDetectionFrame = handle->index % detectionInterval == 0;
+        if (!isDetectionFrame) {
+            detected = tracks.predict(frame);
+            isDetectionFrame = detected.empty() && tracks.size() != 0;
+        }
 
-        detected = detector->detect(test);
-        landmarker->detect(detected);
-        aligner->align(detected, test);
-        recognizer->recognize(detected);
-        if (!prevTest.empty()) {
-            tracked = tracker->track(prevDetected, detected, prevTest, test);
+        if (isDetectionFrame) {
+            detected = detector->detect(frame);
+            landmarker->detect(detected);
+            aligner->align(detected, frame);
+            qualityEstimator->estimate(detected);
         }
+        tracks.update(detected, frame);
+        trackedRecognizer.recognize(detected, tracks);
+
+        test = frame.clone();
 
         for (std::size_t i = 0; i < detected.size(); ++i) {
             faces::Face const &f = detected[i];
@@ -136,42 +174,37 @@ int main(int argc, char **argv) {
             cv::rectangle(test, f.rect, {0, 255, 0});
             cv::putText(test, std::to_string(f.label), f.rect.tl(),
                         cv::FONT_HERSHEY_SIMPLEX, 0.7, {255, 255, 255}, 2);
+            cv::putText(test, fmt::format("{:#x}", f.trackId), f.rect.br(),
+                        cv::FONT_HERSHEY_SIMPLEX, 0.5, {0, 255, 255}, 1);
 
             for (cv::Point const &pt : f.landmarks) {
                 cv::Point realPt = f.rect.tl() + pt;
                 cv::circle(test, realPt, 2, {0, 0, 255}, cv::FILLED, cv::LINE_AA);
             }
 
-            std::string faceWinName = std::to_string(i) + " " + std::to_string(f.label);
-            cv::namedWindow(faceWinName, cv::WINDOW_GUI_NORMAL | cv::WINDOW_AUTOSIZE);
-            cv::imshow(faceWinName, f.img);
+            // faces propagated by the tracker have no images
+            if (!f.img.empty()) {
+                std::string faceWinName = std::to_string(i) + " " + std::to_string(f.label);
+                cv::namedWindow(faceWinName, cv::WINDOW_GUI_NORMAL | cv::WINDOW_AUTOSIZE);
+                cv::imshow(faceWinName, f.img);
+            }
 
             // std::cout << f.rect << " " << f.label << std::endl;
         }
 
-        for (auto const &trackedPair : tracked) {
-            int const &prev = trackedPair.first;
-            int const &actual = trackedPair.second;
-            if (prev != -1 && actual != -1) {
-                cv::Point prevCenter = (prevDetected[prev].rect.br() + prevDetected[prev].rect.tl()) / 2;
-                cv::Point actualCenter = (detected[actual].rect.br() + detected[actual].rect.tl()) / 2;
-                cv::line(test, prevCenter, actualCenter, {255, 0, 0}, 2);
-            } else {
-                int nonMatchedIdx = std::max(prev, actual);
-                std::vector<faces::Face> const &nonMatchedFrom = prev == -1 ? detected : prevDetected;
-                faces::Face const &nonMatchedFace = nonMatchedFrom[nonMatchedIdx];
-                cv::Point nonMatchedCenter = (nonMatchedFace.rect.br() + nonMatchedFace.rect.tl()) / 2;
-
-                cv::circle(test, nonMatchedCenter, 5, {0, 255, 255}, cv::FILLED);
-            }
-        }
-
-        prevDetected = detected;
-        prevTest = test;
+        // the frame kept by the track manager is not overwritten, the source decodes into a new buffer instead
+        source.release(handle);
 
         cv::imshow("test", test);
         cv::waitKey(1);
     }
 
+    spdlog::info("Recognitions: {}, reused labels: {}, re-identified tracks: {}, deferred: {}, "
+                 "p99 recognition latency: {:.2f} ms",
+                 trackedRecognizer.getRecognitionsCount(), trackedRecognizer.getReusedCount(),
+                 trackedRecognizer.getReidentifiedCount(),
+                 trackedRecognizer.getScheduler().getDeferredCount(),
+                 trackedRecognizer.getScheduler().getLatencyPercentile(0.99));
+
     return 0;
 }
\ No newline at end of file
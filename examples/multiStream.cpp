@@ -0,0 +1,134 @@
+/**
+ * @file multiStream.cpp
+ * @author Люнгрин Андрей aka prostoichelovek <iam.prostoi.chelovek@gmail.ru>
+ * @date 19 Oct 2026
+ * @copyright MIT License
+ *
+ * @brief This file contains an example of processing many videos with the shared components
+ *
+ * Usage: faces_multiStream <video or pipe>...
+ */
+
+#include <spdlog/sinks/stdout_color_sinks.h>
+
+#include <Config/Config.h>
+#include <Detector/Implementations/OcvDefaultDnnDetector.h>
+#include <Landmarker/Implementations/DlibLandmarker.h>
+#include <Aligner/Implementations/DlibChipAligner.h>
+#include <QualityEstimator/Implementations/HeuristicQualityEstimator.h>
+#include <Recognizer/Implementations/Descriptors/DlibResnetSvmRecognizer.h>
+#include <Tracker/Implementations/CentroidTracker.h>
+#include <Pipeline/MultiStreamRuntime.h>
+
+int main(int argc, char **argv) {
+    auto console = spdlog::stdout_color_mt("console", spdlog::color_mode::always);
+    spdlog::set_default_logger(console);
+
+    if (argc < 2) {
+        spdlog::error("Usage: {} <video or pipe>...", argv[0]);
+        return 1;
+    }
+
+    faces::Config &configInstance = faces::Config::getInstance();
+    std::string configFile = FACES_ROOT_DIRECTORY "/config.json";
+    if (!configInstance.config.config(configFile)) {
+        spdlog::error("Cannot load a config from the file '{}'", configFile);
+        return 1;
+    }
+
+    // a single instance of each of the models is shared by all of the streams
+    std::unique_ptr<faces::Detector> detector(FACES_CREATE_INSTANCE(Detector, OcvDefaultDnn, configInstance));
+    std::unique_ptr<faces::Landmarker> landmarker(FACES_CREATE_INSTANCE(Landmarker, Dlib, configInstance));
+    std::unique_ptr<faces::Aligner> aligner(FACES_CREATE_INSTANCE(Aligner, DlibChip, configInstance));
+    std::unique_ptr<faces::QualityEstimator> qualityEstimator(FACES_CREATE_INSTANCE(QualityEstimator, Heuristic,
+                                                                                    configInstance));
+    std::unique_ptr<faces::Recognizer> recognizer(FACES_CREATE_INSTANCE(Recognizer, DlibResnetSvm, configInstance));
+
+    // the descriptors of the faces of all of the streams are computed in shared batches
+    auto *descriptorsRecognizer = dynamic_cast<faces::DescriptorsRecognizer *>(recognizer.get());
+    std::unique_ptr<faces::DescriptorService> descriptorService;
+    if (descriptorsRecognizer != nullptr) {
+        descriptorService = std::make_unique<faces::DescriptorService>(descriptorsRecognizer->descriptor,
+                                                                       configInstance);
+        descriptorsRecognizer->setDescriptorService(descriptorService.get());
+    }
+
+    faces::Pipeline::Components components;
+    components.detectors = {detector.get()};
+    components.landmarkers = {landmarker.get()};
+    components.aligners = {aligner.get()};
+    components.qualityEstimators = {qualityEstimator.get()};
+    components.recognizers = {recognizer.get()};
+
+    faces::MultiStreamRuntime runtime(components, configInstance);
+    if (!runtime.isOk()) {
+        spdlog::error("Cannot start the runtime");
+        return 1;
+    }
+
+    // the trackers are cheap and keep the state of a single stream
+    std::vector<std::unique_ptr<faces::Tracker>> trackers;
+    std::vector<std::thread> readers, consumers;
+    for (int i = 1; i < argc; ++i) {
+        trackers.emplace_back(FACES_CREATE_INSTANCE(Tracker, Centroid, configInstance));
+        faces::MultiStreamRuntime::StreamId id = runtime.addStream(trackers.back().get());
+
+        readers.emplace_back([&runtime, id, source = std::string(argv[i])]() {
+            cv::VideoCapture cap(source);
+            cv::Mat frame;
+            for (std::size_t idx = 0; cap.read(frame); ++idx) {
+                runtime.submit(id, {idx, faces::MultiStreamRuntime::Clock::now(), frame, {}});
+                // the runtime may still use the buffer of the submitted frame
+                frame = cv::Mat();
+            }
+            runtime.closeStream(id);
+        });
+        consumers.emplace_back([&runtime, id]() {
+            faces::MultiStreamRuntime::Frame result;
+            while (runtime.next(id, result)) {}
+        });
+    }
+
+    // the statistics are printed while the streams are running
+    std::atomic<bool> isDone = false;
+    std::thread reporter([&runtime, &isDone, &descriptorService]() {
+        while (!isDone) {
+            std::this_thread::sleep_for(std::chrono::seconds(5));
+            for (std::size_t id = 0; id < runtime.getStreamsCount(); ++id) {
+                faces::MultiStreamRuntime::StreamStats stats = runtime.getStats(id);
+                spdlog::info("Stream {}: {:.1f} FPS, {} processed, {} dropped, {} queued",
+                             id, stats.fps, stats.processed, stats.dropped, stats.queueDepth);
+            }
+
+            if (descriptorService) {
+                std::vector<std::size_t> fills = descriptorService->getBatchFillHistogram();
+                std::size_t batches = 0, imgs = 0;
+                for (std::size_t size = 0; size < fills.size(); ++size) {
+                    batches += fills[size];
+                    imgs += fills[size] * size;
+                }
+
+                // the 0-th bucket is for less than a microsecond, the i-th one is for less than 2^i
+                std::vector<std::size_t> delays = descriptorService->getQueueDelayHistogram();
+                std::size_t waited = 0, medianBucket = 0;
+                for (; medianBucket < delays.size() && waited * 2 < imgs; ++medianBucket) {
+                    waited += delays[medianBucket];
+                }
+                spdlog::info("Descriptors: {} batches, {:.1f} faces per batch, median queue delay < {} us",
+                             batches, batches != 0 ? static_cast<double>(imgs) / batches : 0.0,
+                             std::size_t(1) << (medianBucket == 0 ? 0 : medianBucket - 1));
+            }
+        }
+    });
+
+    for (std::thread &reader : readers) {
+        reader.join();
+    }
+    for (std::thread &consumer : consumers) {
+        consumer.join();
+    }
+    isDone = true;
+    reporter.join();
+
+    return 0;
+}
@@ -0,0 +1,136 @@
+/**
+ * @file pipelineBenchmark.cpp
+ * @author Люнгрин Андрей aka prostoichelovek <iam.prostoi.chelovek@gmail.ru>
+ * @date 19 Oct 2026
+ * @copyright MIT License
+ *
+ * @brief This file contains a comparison of the single-threaded loop and the Pipeline on the same video
+ *
+ * Usage: faces_pipelineBenchmark <video> [max frames] [detectors count]
+ */
+
+#include <chrono>
+
+#include <spdlog/sinks/stdout_color_sinks.h>
+
+#include <Config/Config.h>
+#include <Detector/Implementations/OcvDefaultDnnDetector.h>
+#include <Landmarker/Implementations/DlibLandmarker.h>
+#include <Aligner/Implementations/DlibChipAligner.h>
+#include <QualityEstimator/Implementations/HeuristicQualityEstimator.h>
+#include <Recognizer/Implementations/Descriptors/DlibResnetSvmRecognizer.h>
+#include <Tracker/Implementations/CentroidTracker.h>
+#include <Pipeline/Pipeline.h>
+
+int main(int argc, char **argv) {
+    auto console = spdlog::stdout_color_mt("console", spdlog::color_mode::always);
+    spdlog::set_default_logger(console);
+
+    if (argc < 2) {
+        spdlog::error("Usage: {} <video> [max frames] [detectors count]", argv[0]);
+        return 1;
+    }
+    std::size_t maxFrames = argc > 2 ? std::stoul(argv[2]) : 300;
+    std::size_t detectorsCount = argc > 3 ? std::stoul(argv[3]) : 1;
+
+    faces::Config &configInstance = faces::Config::getInstance();
+    std::string configFile = FACES_ROOT_DIRECTORY "/config.json";
+    if (!configInstance.config.config(configFile)) {
+        spdlog::error("Cannot load a config from the file '{}'", configFile);
+        return 1;
+    }
+
+    // the frames are decoded beforehand, so only the processing is measured
+    std::vector<cv::Mat> frames;
+    cv::VideoCapture cap(argv[1]);
+    for (cv::Mat frame; frames.size() < maxFrames && cap.read(frame); frame = cv::Mat()) {
+        frames.emplace_back(frame);
+    }
+    if (frames.empty()) {
+        spdlog::error("Cannot read frames from '{}'", argv[1]);
+        return 1;
+    }
+
+    std::vector<std::unique_ptr<faces::Detector>> detectors;
+    for (std::size_t i = 0; i < std::max<std::size_t>(detectorsCount, 1); ++i) {
+        detectors.emplace_back(FACES_CREATE_INSTANCE(Detector, OcvDefaultDnn, configInstance));
+    }
+    std::unique_ptr<faces::Landmarker> landmarker(FACES_CREATE_INSTANCE(Landmarker, Dlib, configInstance));
+    std::unique_ptr<faces::Aligner> aligner(FACES_CREATE_INSTANCE(Aligner, DlibChip, configInstance));
+    std::unique_ptr<faces::QualityEstimator> qualityEstimator(FACES_CREATE_INSTANCE(QualityEstimator, Heuristic,
+                                                                                    configInstance));
+    std::unique_ptr<faces::Recognizer> recognizer(FACES_CREATE_INSTANCE(Recognizer, DlibResnetSvm, configInstance));
+    std::unique_ptr<faces::Tracker> tracker(FACES_CREATE_INSTANCE(Tracker, Centroid, configInstance));
+
+    bool isOk = std::all_of(detectors.begin(), detectors.end(),
+                            [](auto const &detector) { return detector && detector->isOk(); });
+    if (!isOk || !landmarker || !landmarker->isOk() || !aligner || !aligner->isOk()
+        || !qualityEstimator || !qualityEstimator->isOk() || !recognizer || !recognizer->isOk()
+        || !tracker || !tracker->isOk()) {
+        spdlog::error("Cannot load some component!");
+        return 1;
+    }
+
+    // Single-threaded loop ->
+    {
+        faces::TrackManager tracks(tracker.get(), configInstance);
+
+        auto start = std::chrono::steady_clock::now();
+        for (cv::Mat const &frame : frames) {
+            std::vector<faces::Face> detected = detectors.front()->detect(frame);
+            landmarker->detect(detected);
+            aligner->align(detected, frame);
+            qualityEstimator->estimate(detected);
+            recognizer->recognize(detected);
+            tracks.update(detected, frame);
+        }
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+        spdlog::info("Single-threaded loop: {:.1f} FPS", frames.size() / elapsed.count());
+    }
+    // <- Single-threaded loop
+
+    // Pipeline ->
+    {
+        faces::TrackManager tracks(tracker.get(), configInstance);
+
+        faces::Pipeline::Components components;
+        for (auto const &detector : detectors) {
+            components.detectors.emplace_back(detector.get());
+        }
+        components.landmarkers = {landmarker.get()};
+        components.aligners = {aligner.get()};
+        components.qualityEstimators = {qualityEstimator.get()};
+        components.recognizers = {recognizer.get()};
+        components.tracks = &tracks;
+
+        faces::Pipeline pipeline(components, configInstance);
+        if (!pipeline.isOk()) {
+            spdlog::error("Cannot start the pipeline");
+            return 1;
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        std::thread consumer([&pipeline]() {
+            faces::Pipeline::Frame result;
+            while (pipeline.next(result)) {}
+        });
+        for (std::size_t i = 0; i < frames.size(); ++i) {
+            pipeline.submit({i, faces::Pipeline::Clock::now(), frames[i], {}});
+        }
+        pipeline.close();
+        consumer.join();
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+        spdlog::info("Pipeline with {} detectors: {:.1f} FPS, {} frames dropped, {} deadline misses",
+                     detectors.size(), pipeline.getDeliveredCount() / elapsed.count(), pipeline.getDroppedCount(),
+                     pipeline.getDeadlineMissesCount());
+        for (faces::Pipeline::StageStats const &stage : pipeline.getStageStats()) {
+            spdlog::info("\t{}: {:.2f} ms, {} processed, {} dropped, {} skipped",
+                         stage.name, stage.duration, stage.processed, stage.dropped, stage.skipped);
+        }
+    }
+    // <- Pipeline
+
+    return 0;
+}
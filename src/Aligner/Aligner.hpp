@@ -12,6 +12,7 @@
 
 #include <Face/Face.h>
 #include <Config/Config.h>
+#include <utils/Async.hpp>
 
 namespace faces {
 
@@ -56,6 +57,22 @@ namespace faces {
             }
         }
 
+        /**
+         * Aligns the given faces on the ThreadPool;
+         * the asynchronous calls of an aligner run one at a time in the order of the calls
+         *
+         * @param faces    - faces, process the images of which
+         * @param wholeImg - an image where the faces were detected
+         *
+         * @return a future of the aligned faces
+         */
+        Future<std::vector<Face>> alignAsync(std::vector<Face> faces, cv::Mat wholeImg) {
+            return _strand.run([this, faces, wholeImg]() mutable {
+                align(faces, wholeImg);
+                return std::move(faces);
+            });
+        }
+
         /**
          * @return a value of the @ref _ok flag
          */
@@ -67,6 +84,9 @@ namespace faces {
         /// the flag which indicates the readiness of the detector
         bool _ok = false;
 
+        /// runs the asynchronous calls one at a time
+        Strand _strand;
+
         /// the desired face size
         cv::Size _faceSize = {150, 150};
 
@@ -0,0 +1,82 @@
+/**
+ * @file SfaceAligner.cpp
+ * @author Люнгрин Андрей aka prostoichelovek <iam.prostoi.chelovek@gmail.ru>
+ * @date 19 Oct 2026
+ * @copyright MIT License
+ */
+
+#include "SfaceAligner.h"
+
+namespace faces {
+
+    SfaceAligner::SfaceAligner(const Config &config) : Aligner(config) {
+        _faceSize = {112, 112};
+        _ok = true;
+    }
+
+    cv::Mat SfaceAligner::_align(Face const &face, cv::Mat const &wholeImg) {
+        std::vector<cv::Point2f> src, dst;
+        if (!_getPoints(face, src, dst)) {
+            spdlog::error("The SfaceAligner requires 5 or 68 landmarks, but the face has {}", face.landmarks.size());
+            return face.img;
+        }
+
+        cv::Mat chip;
+        cv::warpAffine(wholeImg, chip, _estimateSimilarity(src, dst), _faceSize);
+        return chip;
+    }
+
+    bool SfaceAligner::_getPoints(Face const &face, std::vector<cv::Point2f> &src, std::vector<cv::Point2f> &dst) {
+        std::vector<cv::Point> landmarks = face.getRectLandmarks();
+        auto mean = [&landmarks](std::size_t first, std::size_t last) {
+            cv::Point2f sum;
+            for (std::size_t i = first; i <= last; ++i) {
+                sum += cv::Point2f(landmarks[i]);
+            }
+            return sum / static_cast<float>(last - first + 1);
+        };
+
+        if (landmarks.size() == 68) {
+            src = {mean(36, 41), mean(42, 47), landmarks[30], landmarks[48], landmarks[54]};
+        } else if (landmarks.size() == 5) {
+            // the corners of the eye on the right of the image come first
+            src = {mean(2, 3), mean(0, 1)};
+        } else {
+            return false;
+        }
+
+        dst.clear();
+        for (std::size_t i = 0; i < src.size(); ++i) {
+            dst.emplace_back(_template[i][0], _template[i][1]);
+        }
+        return true;
+    }
+
+    cv::Mat SfaceAligner::_estimateSimilarity(std::vector<cv::Point2f> const &src,
+                                              std::vector<cv::Point2f> const &dst) {
+        cv::Point2f srcMean, dstMean;
+        for (std::size_t i = 0; i < src.size(); ++i) {
+            srcMean += src[i];
+            dstMean += dst[i];
+        }
+        srcMean /= static_cast<float>(src.size());
+        dstMean /= static_cast<float>(dst.size());
+
+        // [a -b; b a] minimizes the squared distances between the centered points
+        double a = 0, b = 0, norm = 0;
+        for (std::size_t i = 0; i < src.size(); ++i) {
+            cv::Point2d s = src[i] - srcMean, d = dst[i] - dstMean;
+            a += s.x * d.x + s.y * d.y;
+            b += s.x * d.y - s.y * d.x;
+            norm += s.x * s.x + s.y * s.y;
+        }
+        if (norm > 0) {
+            a /= norm;
+            b /= norm;
+        }
+
+        return (cv::Mat_<double>(2, 3) << a, -b, dstMean.x - (a * srcMean.x - b * srcMean.y),
+                b, a, dstMean.y - (b * srcMean.x + a * srcMean.y));
+    }
+
+}
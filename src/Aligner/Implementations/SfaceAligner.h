@@ -0,0 +1,61 @@
+/**
+ * @file SfaceAligner.h
+ * @author Люнгрин Андрей aka prostoichelovek <iam.prostoi.chelovek@gmail.ru>
+ * @date 19 Oct 2026
+ * @copyright MIT License
+ *
+ * @brief This file contains a face aligner, which produces the 112x112 chips expected by SFace
+ */
+
+#ifndef FACES_SFACEALIGNER_H
+#define FACES_SFACEALIGNER_H
+
+#include <array>
+
+#include <Aligner/Aligner.hpp>
+
+namespace faces {
+
+    /**
+     * A face aligner, which maps the landmarks onto the 5-point 112x112 template SFace was trained with
+     * by a least-squares similarity transform, the same way cv::FaceRecognizerSF::alignCrop does. @n
+     * With 68 landmarks the eye centers, the nose tip and the mouth corners are used;
+     * with the 5 landmarks of dlib only the eye centers are used, since its nose point is not on the template. @n
+     * The chips are always 112x112, regardless of `Aligner.faceWidth` and `Aligner.faceHeight`
+     *
+     * @see https://github.com/opencv/opencv/blob/4.x/modules/objdetect/src/face_recognize.cpp
+     */
+    class SfaceAligner : public Aligner {
+    public:
+        FACES_MAIN_CONSTRUCTOR(explicit SfaceAligner, Config const &config);
+
+    protected:
+        /// the template points: left eye, right eye, nose tip, left and right mouth corners (in the image)
+        static constexpr std::array<std::array<float, 2>, 5> _template{{
+                {38.2946f, 51.6963f}, {73.5318f, 51.5014f}, {56.0252f, 71.7366f},
+                {41.5493f, 92.3655f}, {70.7299f, 92.2041f}}};
+
+        cv::Mat _align(Face const &face, cv::Mat const &wholeImg) override;
+
+        /**
+         * Finds the template points on the face
+         *
+         * @param src - a destination of the points on the image
+         * @param dst - a destination of the matching template points
+         *
+         * @return false if the landmarks of the face are not supported
+         */
+        static bool _getPoints(Face const &face, std::vector<cv::Point2f> &src, std::vector<cv::Point2f> &dst);
+
+        /**
+         * @return a 2x3 least-squares similarity transform of the src points to the dst ones
+         */
+        static cv::Mat _estimateSimilarity(std::vector<cv::Point2f> const &src, std::vector<cv::Point2f> const &dst);
+
+    };
+
+    FACES_REGISTER_SUBCLASS(Aligner, SfaceAligner, Sface)
+
+}
+
+#endif //FACES_SFACEALIGNER_H
@@ -16,6 +16,7 @@
 
 #include "Face/Face.h"
 #include "utils/utils.h"
+#include "utils/Async.hpp"
 
 namespace faces {
 
@@ -39,6 +40,36 @@ namespace faces {
             return _detect(img);
         }
 
+        /**
+         * Detect faces on each of the given images;
+         * the detectors, which support it, process the images in a single batch. @n
+         * It is just a wrapper around @ref _detectBatch, which checks the @ref _ok flag
+         *
+         * @param imgs - images, detect faces on
+         *
+         * @return a vector of faces detected on each of the images OR an empty vector,
+         *         in case @ref _ok was set to `false`
+         */
+        std::vector<std::vector<Face>> detect(std::vector<cv::Mat> const &imgs) {
+            if (!_ok) {
+                return {};
+            }
+            return _detectBatch(imgs);
+        }
+
+        /**
+         * Detects faces on the given image on the ThreadPool;
+         * the asynchronous calls of a detector run one at a time in the order of the calls. @n
+         * The image is shared with the call, so it should not be modified until the future is ready
+         *
+         * @param img - image, detect faces on
+         *
+         * @return a future of the detected faces
+         */
+        Future<std::vector<Face>> detectAsync(cv::Mat img) {
+            return _strand.run([this, img]() { return detect(img); });
+        }
+
         /**
          * @return a value of the @ref _ok flag
          */
@@ -50,6 +81,9 @@ namespace faces {
         /// the flag which indicates the readiness of the detector
         bool _ok = false;
 
+        /// runs the asynchronous calls one at a time
+        Strand _strand;
+
         /**
          * The method which actually performs face detection
          *
@@ -59,6 +93,22 @@ namespace faces {
          */
         virtual std::vector<Face> _detect(cv::Mat const &img) = 0;
 
+        /**
+         * Detects faces on each of the given images;
+         * the default implementation detects them one by one
+         *
+         * @param imgs - images, detect faces on
+         *
+         * @return a vector of faces detected on each of the images
+         */
+        virtual std::vector<std::vector<Face>> _detectBatch(std::vector<cv::Mat> const &imgs) {
+            std::vector<std::vector<Face>> res;
+            for (cv::Mat const &img : imgs) {
+                res.emplace_back(_detect(img));
+            }
+            return res;
+        }
+
     };
 
 }
@@ -27,4 +27,8 @@ namespace faces {
 
         return {x1, y1, x2, y2};
     }
+
+    int OcvDefaultDnnDetector::extractImageIndex(cv::Mat const &detection, int const &index) {
+        return static_cast<int>(detection.at<float>(index, 0));
+    }
 }
\ No newline at end of file
@@ -38,6 +38,8 @@ namespace faces {
         float extractConfidence(cv::Mat const &detection, int const &index) override;
 
         cv::Vec4i extractPoints(cv::Mat const &detection, int const &index, cv::Size const &imgSize) override;
+
+        int extractImageIndex(cv::Mat const &detection, int const &index) override;
     };
 
     FACES_REGISTER_SUBCLASS(Detector, OcvDefaultDnnDetector, OcvDefaultDnn)
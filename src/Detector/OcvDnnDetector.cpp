@@ -45,25 +45,53 @@ namespace faces {
         cv::Mat detectionMat = prepareDetectionMat(detection);
 
         for (int i = 0; i < extractIterationLimit(detectionMat); ++i) {
-            float confidence = extractConfidence(detectionMat, i);
-            if (confidence < get_confidenceThreshold()) {
-                continue;
-            }
+            addFace(detectionMat, i, img, res);
+        }
 
-            cv::Vec4i cords = extractPoints(detectionMat, i, img.size());
+        return res;
+    }
 
-            cv::Rect faceRect(cv::Point(cords[0], cords[1]),
-                              cv::Point(cords[2], cords[3]));
-            // constrain the rect within the image boundaries
-            faceRect &= cv::Rect({0, 0}, img.size());
-            cv::Mat faceRoi(img(faceRect));
-            Face f(faceRoi, faceRect);
-            res.emplace_back(f);
+    std::vector<std::vector<Face>> OcvDnnDetector::_detectBatch(std::vector<cv::Mat> const &imgs) {
+        if (imgs.size() < 2) {
+            return Detector::_detectBatch(imgs);
+        }
+
+        std::vector<std::vector<Face>> res(imgs.size());
+
+        // the images are resized to the input size, so they do not have to be of the same size
+        cv::Mat inputBlob = cv::dnn::blobFromImages(imgs, get_inScaleFactor(), get_inSize(), get_meanVal(),
+                                                    get_swaptRB(), false);
+        net.setInput(inputBlob, get_inputName());
+        cv::Mat detection = net.forward(get_outputName());
+        cv::Mat detectionMat = prepareDetectionMat(detection);
+
+        for (int i = 0; i < extractIterationLimit(detectionMat); ++i) {
+            int imgIdx = extractImageIndex(detectionMat, i);
+            if (imgIdx >= 0 && imgIdx < static_cast<int>(imgs.size())) {
+                addFace(detectionMat, i, imgs[imgIdx], res[imgIdx]);
+            }
         }
 
         return res;
     }
 
+    void OcvDnnDetector::addFace(cv::Mat const &detection, int index, cv::Mat const &img, std::vector<Face> &faces) {
+        float confidence = extractConfidence(detection, index);
+        if (confidence < get_confidenceThreshold()) {
+            return;
+        }
+
+        cv::Vec4i cords = extractPoints(detection, index, img.size());
+
+        cv::Rect faceRect(cv::Point(cords[0], cords[1]),
+                          cv::Point(cords[2], cords[3]));
+        // constrain the rect within the image boundaries
+        faceRect &= cv::Rect({0, 0}, img.size());
+        cv::Mat faceRoi(img(faceRect));
+        Face f(faceRoi, faceRect);
+        faces.emplace_back(f);
+    }
+
     cv::Mat OcvDnnDetector::createBlob(cv::Mat const &img) {
         return cv::dnn::blobFromImage(img, get_inScaleFactor(), get_inSize(), get_meanVal(),
                                       get_swaptRB(), false);
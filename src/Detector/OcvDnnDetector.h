@@ -67,6 +67,21 @@ namespace faces {
          */
         std::vector<Face> _detect(cv::Mat const &img) override;
 
+        /**
+         * Forwards all of the images through the neural network as a single blob
+         */
+        std::vector<std::vector<Face>> _detectBatch(std::vector<cv::Mat> const &imgs) override;
+
+        /**
+         * Adds a face of the prediction to the given faces, if its confidence is high enough
+         *
+         * @param detection - a matrix obtained from @ref prepareDetectionMat
+         * @param index     - index of the prediction
+         * @param img       - an image, which the prediction belongs to
+         * @param faces     - faces of the image
+         */
+        void addFace(cv::Mat const &detection, int index, cv::Mat const &img, std::vector<Face> &faces);
+
         /**
          * Creates a blob from the given image, to fit into the DNN
          *
@@ -127,6 +142,16 @@ namespace faces {
                                         int const &index,
                                         cv::Size const &imgSize) = 0;
 
+        /**
+         * Extracts an index of the image in a batch, which the prediction belongs to
+         *
+         * @param detection - a matrix obtained from @ref prepareDetectionMat
+         * @param index     - index of the prediction
+         *
+         * @return an index of the image in the blob
+         */
+        virtual int extractImageIndex(cv::Mat const &detection, int const &index) = 0;
+
     };
 
     FACES_AUGMENT_CONFIG(OcvDnnDetector,
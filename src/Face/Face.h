@@ -10,12 +10,36 @@
 #ifndef FACES_FACE_H
 #define FACES_FACE_H
 
+#include <cstdint>
 #include <utility>
 
 #include <opencv2/opencv.hpp>
 
 namespace faces {
 
+    /**
+     * Quality measures of a face, estimated by a QualityEstimator
+     */
+    struct FaceQuality {
+        /// a variance of the Laplacian of the face image; the lower, the blurrier
+        double sharpness = -1;
+
+        /// a size of the smaller side of the face rect in pixels
+        double size = -1;
+
+        /// a mean brightness of the face image in range [0, 1]
+        double exposure = -1;
+
+        /// an approximate head yaw in degrees estimated from landmarks, 0 is frontal
+        double yaw = 0;
+
+        /// an overall quality score in range [0, 1] OR -1 if it was not estimated
+        double score = -1;
+
+        /// whether the face is good enough to be recognized
+        bool acceptable = true;
+    };
+
     /**
      * This is the class representing faces.
      */
@@ -33,6 +57,15 @@ namespace faces {
         /// A prepared image of the face
         cv::Mat img;
 
+        /// Quality of the face image
+        FaceQuality quality;
+
+        /// A descriptor of the face computed during the recognition OR an empty vector
+        std::vector<double> descriptor;
+
+        /// An id of the track of this face assigned by the TrackManager OR 0 if it is not tracked
+        std::uint64_t trackId = 0;
+
         Face() = default;
 
         explicit Face(cv::Rect rect)
@@ -0,0 +1,174 @@
+/**
+ * @file FrameSource.cpp
+ * @author Люнгрин Андрей aka prostoichelovek <iam.prostoi.chelovek@gmail.ru>
+ * @date 19 Oct 2026
+ * @copyright MIT License
+ */
+
+#include "FrameSource.h"
+
+namespace faces {
+
+    FrameSource::FrameSource(Config const &config) {
+        try {
+            _bufferSize = std::max(1, config["FrameSource.bufferSize"].getInt());
+            setDecimation(std::max(1, config["FrameSource.decimation"].getInt()));
+        } catch (std::out_of_range &e) {
+            spdlog::error("Cannot get parameters of the FrameSource from the config, using the default ones");
+        }
+
+        _frames.resize(_bufferSize);
+        _frameEpochs.resize(_bufferSize, 0);
+        _free = std::make_unique<SlotQueue>(_bufferSize);
+        _decoded = std::make_unique<SlotQueue>(_bufferSize);
+        for (std::size_t slot = 0; slot < _bufferSize; ++slot) {
+            _free->push(slot);
+        }
+    }
+
+    FrameSource::~FrameSource() {
+        _stop();
+    }
+
+    bool FrameSource::next(Handle &handle) {
+        std::size_t slot;
+        while (_ok && _decoded->pop(slot)) {
+            // the frame was decoded before a seek
+            if (_frameEpochs[slot] != _epoch) {
+                _free->push(slot);
+                continue;
+            }
+
+            handle = Handle(slot, &_frames[slot]);
+            return true;
+        }
+        return false;
+    }
+
+    bool FrameSource::tryNext(Handle &handle) {
+        std::size_t slot;
+        while (_ok && _decoded->tryPop(slot)) {
+            if (_frameEpochs[slot] != _epoch) {
+                _free->push(slot);
+                continue;
+            }
+
+            handle = Handle(slot, &_frames[slot]);
+            return true;
+        }
+        return false;
+    }
+
+    void FrameSource::release(Handle &handle) {
+        if (!handle.isValid()) {
+            return;
+        }
+
+        _free->push(handle._slot);
+        handle = Handle();
+    }
+
+    void FrameSource::seek(double timestamp) {
+        std::lock_guard<std::mutex> lock(_seekMutex);
+        _seekTarget = timestamp;
+        ++_epoch;
+    }
+
+    bool FrameSource::_skip() {
+        return _read(_scratch);
+    }
+
+    void FrameSource::_preallocate(cv::Size const &size, int type) {
+        if (size.empty()) {
+            return;
+        }
+
+        for (Frame &frame : _frames) {
+            frame.img.create(size, type);
+            ++_allocationsCount;
+        }
+    }
+
+    void FrameSource::_start() {
+        if (_ok && !_decoder.joinable()) {
+            _decoder = std::thread(&FrameSource::_decode, this);
+        } else if (!_ok) {
+            _decoded->close();
+        }
+    }
+
+    void FrameSource::_stop() {
+        _isStopping = true;
+        // the frames given back after this are just not decoded into
+        _free->close();
+        if (_decoder.joinable()) {
+            _decoder.join();
+        }
+    }
+
+    void FrameSource::_decode() {
+        std::size_t slot;
+        // the first frame after the start or a seek is not skipped
+        std::size_t lastEpoch = 0;
+        bool isFirst = true;
+        // a number of the shared buffers met in a row
+        std::size_t sharedCount = 0;
+        Backoff backoff;
+        while (!_isStopping && _free->pop(slot) && !_isStopping) {
+            // the buffer is still referenced elsewhere, so it is given back, and the next free one is tried;
+            // the counter is changed by the other threads, so it is read atomically, the same way as cv::Mat does
+            cv::Mat const &img = _frames[slot].img;
+            if (img.u != nullptr && CV_XADD(&img.u->refcount, 0) > 1) {
+                _free->push(slot);
+                if (++sharedCount >= _bufferSize) {
+                    backoff.wait();
+                }
+                continue;
+            }
+            sharedCount = 0;
+            backoff.reset();
+
+            std::size_t epoch = _applySeek();
+            if (epoch != lastEpoch) {
+                lastEpoch = epoch;
+                isFirst = true;
+            }
+            Frame &frame = _frames[slot];
+
+            bool isOver = false;
+            for (std::size_t i = 1; i < _decimation && !isFirst && !isOver; ++i) {
+                isOver = !_skip();
+            }
+            if (isOver) {
+                break;
+            }
+
+            uchar const *data = frame.img.data;
+            if (!_read(frame) || frame.img.empty()) {
+                break;
+            }
+            if (frame.img.data != data) {
+                ++_allocationsCount;
+            }
+            isFirst = false;
+
+            frame.captureTime = Clock::now();
+            _frameEpochs[slot] = epoch;
+            _decoded->push(slot);
+        }
+
+        _decoded->close();
+    }
+
+    std::size_t FrameSource::_applySeek() {
+        std::lock_guard<std::mutex> lock(_seekMutex);
+        if (_appliedEpoch != _epoch) {
+            if (!_seek(_seekTarget)) {
+                spdlog::warn("The frame source cannot seek to {} ms", _seekTarget);
+            }
+            _appliedEpoch = _epoch;
+        }
+        return _appliedEpoch;
+    }
+
+}
@@ -0,0 +1,257 @@
+/**
+ * @file FrameSource.h
+ * @author Люнгрин Андрей aka prostoichelovek <iam.prostoi.chelovek@gmail.ru>
+ * @date 19 Oct 2026
+ * @copyright MIT License
+ *
+ * @brief This file contains a base class for the sources of frames, which decode ahead on their own thread
+ */
+
+#ifndef FACES_FRAMESOURCE_H
+#define FACES_FRAMESOURCE_H
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <opencv2/opencv.hpp>
+#include <spdlog/spdlog.h>
+
+#include <Config/Config.h>
+#include <utils/BoundedQueue.hpp>
+
+namespace faces {
+
+    /**
+     * A base class for the sources of frames (videos, cameras, directories of images),
+     * which decode the frames on their own thread, so the decoding overlaps with the processing. @n
+     * The frames are decoded into a fixed ring of buffers, which are allocated once and reused,
+     * so the source does not allocate in the steady state. A frame is taken by a Handle and stays valid
+     * until it is given back by @ref release; the decoding waits if all of the buffers are taken. @n
+     * A frame referenced elsewhere after its release (e.g. kept by the TrackManager) is not overwritten:
+     * its buffer is given back to the free ones and skipped, while it is shared, so the decoding uses the others
+     * and waits with a backoff if all of them are shared. @n
+     * The source may decode only every N-th frame (`decimation`), skipping the others as cheaply as it can,
+     * e.g. without the colour conversion and copying. @n
+     * The derived classes should call @ref _start at the end of their constructors
+     * and @ref _stop at the beginning of their destructors
+     */
+    class FrameSource {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        /**
+         * A decoded frame
+         */
+        struct Frame {
+            /// an index of the frame in the source
+            std::size_t index = 0;
+            /// a position of the frame in the source in milliseconds
+            double timestamp = 0;
+            /// a time when the frame was decoded
+            Clock::time_point captureTime;
+            cv::Mat img;
+        };
+
+        /**
+         * A reference to a frame in the ring, which should be given back by @ref release
+         */
+        class Handle {
+        public:
+            Handle() = default;
+
+            [[nodiscard]] bool isValid() const {
+                return _frame != nullptr;
+            }
+
+            Frame const &operator*() const {
+                return *_frame;
+            }
+
+            Frame const *operator->() const {
+                return _frame;
+            }
+
+        private:
+            friend class FrameSource;
+
+            std::size_t _slot = 0;
+            Frame const *_frame = nullptr;
+
+            Handle(std::size_t slot, Frame const *frame)
+                    : _slot(slot), _frame(frame) {}
+
+        };
+
+        explicit FrameSource(Config const &config);
+
+        virtual ~FrameSource();
+
+        FrameSource(FrameSource const &) = delete;
+
+        FrameSource &operator=(FrameSource const &) = delete;
+
+        /**
+         * Takes the next decoded frame waiting for it
+         *
+         * @param handle - a destination of the handle of the frame
+         *
+         * @return false if the source is over and all of the frames are taken
+         */
+        bool next(Handle &handle);
+
+        /**
+         * Takes the next decoded frame if it is ready
+         *
+         * @return whether a frame was taken
+         */
+        bool tryNext(Handle &handle);
+
+        /**
+         * Gives the buffer of the frame back to the decoder; the handle becomes invalid
+         */
+        void release(Handle &handle);
+
+        /**
+         * Moves the source to the given position, if it supports seeking, while it is not over;
+         * the frames decoded ahead, but not taken yet, are discarded
+         *
+         * @param timestamp - a position in the source in milliseconds
+         */
+        void seek(double timestamp);
+
+        /**
+         * Sets a number of the frames to advance by for each decoded one, starting from the next one
+         */
+        void setDecimation(std::size_t decimation) {
+            _decimation = std::max<std::size_t>(decimation, 1);
+        }
+
+        [[nodiscard]] std::size_t getDecimation() const {
+            return _decimation;
+        }
+
+        /**
+         * @return a number of the buffers allocated by the decoding, including the initial ones
+         */
+        [[nodiscard]] std::size_t getAllocationsCount() const {
+            return _allocationsCount;
+        }
+
+        /**
+         * @return a number of the decoded frames, which are not taken yet
+         */
+        [[nodiscard]] std::size_t getReadyCount() const {
+            return _decoded ? _decoded->size() : 0;
+        }
+
+        /**
+         * @return a value of the @ref _ok flag
+         */
+        [[nodiscard]] bool isOk() const {
+            return _ok;
+        }
+
+    protected:
+        /// the flag which indicates that the source is opened
+        bool _ok = false;
+
+        /// a number of the buffers in the ring
+        std::size_t _bufferSize = 4;
+
+        /// a number of the frames to advance by for each decoded one
+        std::atomic<std::size_t> _decimation = 1;
+
+        /**
+         * Decodes the next frame of the source into the image of the given frame,
+         * which should be reused if it has the right size and type, and sets its index and timestamp
+         *
+         * @param frame - the frame in the ring
+         *
+         * @return false if the source is over
+         */
+        virtual bool _read(Frame &frame) = 0;
+
+        /**
+         * Advances past the next frame without decoding it, if the source can;
+         * the default implementation decodes it into a scratch buffer
+         *
+         * @return false if the source is over
+         */
+        virtual bool _skip();
+
+        /**
+         * Moves the source to the given position; it is called on the decoding thread
+         *
+         * @param timestamp - a position in the source in milliseconds
+         *
+         * @return false if the source does not support seeking
+         */
+        virtual bool _seek(double timestamp) {
+            return false;
+        }
+
+        /**
+         * Allocates the buffers of the ring, if the size of the frames is known beforehand
+         */
+        void _preallocate(cv::Size const &size, int type);
+
+        /**
+         * Starts the decoding thread
+         */
+        void _start();
+
+        /**
+         * Stops the decoding thread and waits for it
+         */
+        void _stop();
+
+    private:
+        using SlotQueue = BoundedQueue<std::size_t>;
+
+        std::vector<Frame> _frames;
+        /// a seek, after which each of the frames was decoded
+        std::vector<std::size_t> _frameEpochs;
+        Frame _scratch;
+
+        /// the buffers, which may be decoded into
+        std::unique_ptr<SlotQueue> _free;
+        /// the decoded frames in their order
+        std::unique_ptr<SlotQueue> _decoded;
+
+        std::thread _decoder;
+        std::atomic<bool> _isStopping = false;
+
+        std::atomic<std::size_t> _allocationsCount = 0;
+
+        /// a number of the requested seeks; the frames decoded before the last one are discarded
+        std::atomic<std::size_t> _epoch = 0;
+        std::size_t _appliedEpoch = 0;
+        double _seekTarget = 0;
+        std::mutex _seekMutex;
+
+        void _decode();
+
+        /**
+         * Performs the last requested seek, if it is not done yet
+         *
+         * @return the number of the seek, after which the next frame is decoded
+         */
+        std::size_t _applySeek();
+
+    };
+
+    FACES_AUGMENT_CONFIG(FrameSource,
+                         FACES_ADD_CONFIG_OPTION("FrameSource.bufferSize", "frameBufferSize", 4, false,
+                                                 "A number of the frames decoded ahead")
+                                 FACES_ADD_CONFIG_OPTION("FrameSource.decimation", "decimation", 1, false,
+                                                         "Decode only every N-th frame of the source, "
+                                                         "skipping the others without decoding them fully")
+    )
+
+}
+
+#endif //FACES_FRAMESOURCE_H
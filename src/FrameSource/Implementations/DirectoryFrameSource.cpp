@@ -0,0 +1,102 @@
+/**
+ * @file DirectoryFrameSource.cpp
+ * @author Люнгрин Андрей aka prostoichelovek <iam.prostoi.chelovek@gmail.ru>
+ * @date 19 Oct 2026
+ * @copyright MIT License
+ */
+
+#include "DirectoryFrameSource.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <fstream>
+
+namespace faces {
+
+    DirectoryFrameSource::DirectoryFrameSource(std::string const &directory, Config const &config)
+            : FrameSource(config) {
+        try {
+            _fps = config["DirectoryFrameSource.fps"].getNumber();
+        } catch (std::out_of_range &e) {
+            spdlog::error("Cannot get an option 'DirectoryFrameSource.fps' from the config!");
+        }
+
+        std::vector<cv::String> files;
+        try {
+            cv::glob(directory, files, false);
+        } catch (cv::Exception &e) {
+            spdlog::error("Cannot list the directory '{}': {}", directory, e.what());
+        }
+        std::copy_if(files.begin(), files.end(), std::back_inserter(_files), &DirectoryFrameSource::_isImage);
+
+        if (_files.empty()) {
+            spdlog::error("There are no images in the directory '{}'", directory);
+        } else {
+            _ok = true;
+        }
+        _start();
+    }
+
+    DirectoryFrameSource::~DirectoryFrameSource() {
+        _stop();
+    }
+
+    bool DirectoryFrameSource::_read(Frame &frame) {
+        for (; _nextFile < _files.size(); ++_nextFile) {
+            std::ifstream file(_files[_nextFile], std::ios::binary | std::ios::ate);
+            if (file) {
+                _buffer.resize(static_cast<std::size_t>(file.tellg()));
+                file.seekg(0);
+                file.read(reinterpret_cast<char *>(_buffer.data()), static_cast<std::streamsize>(_buffer.size()));
+            }
+            if (!file || _buffer.empty()) {
+                spdlog::warn("Cannot read an image '{}'", _files[_nextFile]);
+                continue;
+            }
+
+            cv::imdecode(_buffer, cv::IMREAD_COLOR, &frame.img);
+            if (frame.img.empty()) {
+                spdlog::warn("Cannot decode an image '{}'", _files[_nextFile]);
+                continue;
+            }
+
+            frame.index = _nextFile++;
+            frame.timestamp = _fps > 0 ? static_cast<double>(frame.index) * 1000 / _fps : 0;
+            return true;
+        }
+        return false;
+    }
+
+    bool DirectoryFrameSource::_skip() {
+        if (_nextFile >= _files.size()) {
+            return false;
+        }
+        ++_nextFile;
+        return true;
+    }
+
+    bool DirectoryFrameSource::_seek(double timestamp) {
+        if (_fps <= 0) {
+            return false;
+        }
+
+        auto idx = static_cast<std::size_t>(std::max(0.0, std::round(timestamp * _fps / 1000)));
+        _nextFile = std::min(idx, _files.size());
+        return true;
+    }
+
+    bool DirectoryFrameSource::_isImage(std::string const &file) {
+        static std::vector<std::string> const extensions{".jpg", ".jpeg", ".png", ".bmp", ".tif", ".tiff", ".webp"};
+
+        std::size_t dot = file.find_last_of('.');
+        if (dot == std::string::npos) {
+            return false;
+        }
+        std::string extension = file.substr(dot);
+        std::transform(extension.begin(), extension.end(), extension.begin(),
+                       [](unsigned char c) { return std::tolower(c); });
+        return std::find(extensions.begin(), extensions.end(), extension) != extensions.end();
+    }
+
+}
@@ -0,0 +1,71 @@
+/**
+ * @file DirectoryFrameSource.h
+ * @author Люнгрин Андрей aka prostoichelovek <iam.prostoi.chelovek@gmail.ru>
+ * @date 19 Oct 2026
+ * @copyright MIT License
+ *
+ * @brief This file contains a source of frames from a directory of images
+ */
+
+#ifndef FACES_DIRECTORYFRAMESOURCE_H
+#define FACES_DIRECTORYFRAMESOURCE_H
+
+#include <Config/Config.h>
+
+#include <FrameSource/FrameSource.h>
+
+namespace faces {
+
+    /**
+     * A source of frames from the images of a directory in the order of their names;
+     * the images, which cannot be decoded, are skipped. @n
+     * The files are read into a reused buffer and decoded into the ring, so they are not allocated per frame,
+     * and the timestamps are derived from the indexes of the images by the configured frame rate,
+     * which is also used to seek. The images skipped by the decimation are not read at all
+     */
+    class DirectoryFrameSource : public FrameSource {
+    public:
+        /**
+         * Lists the images of the directory and starts decoding them
+         *
+         * @param directory - a path to the directory
+         * @param config    - a config with the size of the ring and the frame rate
+         */
+        DirectoryFrameSource(std::string const &directory, Config const &config);
+
+        ~DirectoryFrameSource() override;
+
+        [[nodiscard]] std::size_t getFilesCount() const {
+            return _files.size();
+        }
+
+    protected:
+        std::vector<cv::String> _files;
+        std::size_t _nextFile = 0;
+
+        double _fps = 25;
+
+        /// contents of the current file
+        std::vector<uchar> _buffer;
+
+        bool _read(Frame &frame) override;
+
+        bool _skip() override;
+
+        bool _seek(double timestamp) override;
+
+        /**
+         * @return whether the file has an extension of an image
+         */
+        static bool _isImage(std::string const &file);
+
+    };
+
+    FACES_AUGMENT_CONFIG(DirectoryFrameSource,
+                         FACES_ADD_CONFIG_OPTION("DirectoryFrameSource.fps", "directoryFps", 25, false,
+                                                 "A frame rate to derive the timestamps of the images from")
+    )
+
+}
+
+#endif //FACES_DIRECTORYFRAMESOURCE_H
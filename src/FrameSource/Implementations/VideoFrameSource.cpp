@@ -0,0 +1,74 @@
+/**
+ * @file VideoFrameSource.cpp
+ * @author Люнгрин Андрей aka prostoichelovek <iam.prostoi.chelovek@gmail.ru>
+ * @date 19 Oct 2026
+ * @copyright MIT License
+ */
+
+#include "VideoFrameSource.h"
+
+namespace faces {
+
+    VideoFrameSource::VideoFrameSource(std::string const &source, Config const &config)
+            : FrameSource(config), _capture(source) {
+        _open(source);
+    }
+
+    VideoFrameSource::VideoFrameSource(int camera, Config const &config)
+            : FrameSource(config), _capture(camera) {
+        _open("camera " + std::to_string(camera));
+    }
+
+    VideoFrameSource::~VideoFrameSource() {
+        _stop();
+    }
+
+    void VideoFrameSource::_open(std::string const &name) {
+        if (!_capture.isOpened()) {
+            spdlog::error("Cannot open a video '{}'", name);
+            _start();
+            return;
+        }
+
+        _fps = std::max(0.0, _capture.get(cv::CAP_PROP_FPS));
+        cv::Size size(static_cast<int>(_capture.get(cv::CAP_PROP_FRAME_WIDTH)),
+                      static_cast<int>(_capture.get(cv::CAP_PROP_FRAME_HEIGHT)));
+        _preallocate(size, CV_8UC3);
+
+        _ok = true;
+        _start();
+    }
+
+    bool VideoFrameSource::_read(Frame &frame) {
+        if (!_capture.read(frame.img)) {
+            return false;
+        }
+
+        frame.index = _nextIndex++;
+        // the cameras usually do not report the position, so it is estimated by the frame rate
+        double position = _capture.get(cv::CAP_PROP_POS_MSEC);
+        if (position <= 0 && frame.index != 0 && _fps > 0) {
+            position = static_cast<double>(frame.index) * 1000 / _fps;
+        }
+        frame.timestamp = std::max(0.0, position);
+        return true;
+    }
+
+    bool VideoFrameSource::_skip() {
+        // the frame is decoded, but it is not converted and copied by the retrieval
+        if (!_capture.grab()) {
+            return false;
+        }
+        ++_nextIndex;
+        return true;
+    }
+
+    bool VideoFrameSource::_seek(double timestamp) {
+        if (!_capture.set(cv::CAP_PROP_POS_MSEC, timestamp)) {
+            return false;
+        }
+        _nextIndex = static_cast<std::size_t>(std::max(0.0, _capture.get(cv::CAP_PROP_POS_FRAMES)));
+        return true;
+    }
+
+}
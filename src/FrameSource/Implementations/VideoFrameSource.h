@@ -0,0 +1,76 @@
+/**
+ * @file VideoFrameSource.h
+ * @author Люнгрин Андрей aka prostoichelovek <iam.prostoi.chelovek@gmail.ru>
+ * @date 19 Oct 2026
+ * @copyright MIT License
+ *
+ * @brief This file contains a source of frames of a video or a camera
+ */
+
+#ifndef FACES_VIDEOFRAMESOURCE_H
+#define FACES_VIDEOFRAMESOURCE_H
+
+#include <Config/Config.h>
+
+#include <FrameSource/FrameSource.h>
+
+namespace faces {
+
+    /**
+     * A source of frames read by cv::VideoCapture from a video file, a stream or a camera. @n
+     * The frames skipped by the decimation are only grabbed, so they are not converted and copied,
+     * but they are still decoded, since the later frames depend on them
+     */
+    class VideoFrameSource : public FrameSource {
+    public:
+        /**
+         * Opens the video and starts decoding it
+         *
+         * @param source - a path or an URL of the video
+         * @param config - a config with the size of the ring
+         */
+        VideoFrameSource(std::string const &source, Config const &config);
+
+        /**
+         * Opens the camera and starts capturing from it
+         *
+         * @param camera - an index of the camera
+         * @param config - a config with the size of the ring
+         */
+        VideoFrameSource(int camera, Config const &config);
+
+        ~VideoFrameSource() override;
+
+        /**
+         * @return a frame rate of the video OR 0 if it is unknown
+         */
+        [[nodiscard]] double getFps() const {
+            return _fps;
+        }
+
+    protected:
+        cv::VideoCapture _capture;
+
+        double _fps = 0;
+
+        std::size_t _nextIndex = 0;
+
+        bool _read(Frame &frame) override;
+
+        /**
+         * Grabs the next frame without retrieving it
+         */
+        bool _skip() override;
+
+        bool _seek(double timestamp) override;
+
+        /**
+         * Checks the capture, preallocates the ring by its frame size and starts the decoding
+         */
+        void _open(std::string const &name);
+
+    };
+
+}
+
+#endif //FACES_VIDEOFRAMESOURCE_H
@@ -0,0 +1,278 @@
+/**
+ * @file GalleryFile.cpp
+ * @author Люнгрин Андрей aka prostoichelovek <iam.prostoi.chelovek@gmail.ru>
+ * @date 19 Oct 2026
+ * @copyright MIT License
+ */
+
+#include "GalleryFile.h"
+
+#include <cstring>
+#include <cerrno>
+#include <fstream>
+#include <numeric>
+#include <algorithm>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include <spdlog/spdlog.h>
+
+// the gallery is written and read in the native byte order
+static_assert(__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__, "The gallery file format requires a little-endian host");
+
+namespace faces {
+
+    namespace {
+        std::size_t alignUp(std::size_t value, std::size_t alignment) {
+            return (value + alignment - 1) / alignment * alignment;
+        }
+    }
+
+    std::uint64_t galleryChecksum(char const *data, std::size_t size) {
+        std::uint64_t hash = 14695981039346656037ULL;
+        for (std::size_t i = 0; i + sizeof(std::uint64_t) <= size; i += sizeof(std::uint64_t)) {
+            std::uint64_t word;
+            std::memcpy(&word, data + i, sizeof(word));
+            hash ^= word;
+            hash *= 1099511628211ULL;
+        }
+        return hash;
+    }
+
+    std::vector<char> serializeGallery(std::vector<int> const &labels,
+                                       std::vector<std::vector<double>> const &descriptors) {
+        if (labels.size() != descriptors.size()) {
+            throw std::invalid_argument("Number of labels does not match number of descriptors");
+        }
+
+        std::size_t const count = descriptors.size();
+        std::size_t const dimension = descriptors.empty() ? 0 : descriptors.front().size();
+        std::size_t const stride = alignUp(dimension, GalleryHeader::alignment / sizeof(float));
+        for (auto const &descriptor : descriptors) {
+            if (descriptor.size() != dimension) {
+                throw std::invalid_argument("Descriptors of a gallery should have the same size");
+            }
+        }
+
+        // rows are sorted by label, so rows of each label are contiguous
+        std::vector<std::size_t> order(count);
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(),
+                         [&](std::size_t a, std::size_t b) { return labels[a] < labels[b]; });
+
+        std::vector<GalleryIndexEntry> index;
+        for (std::size_t row = 0; row < count; ++row) {
+            int label = labels[order[row]];
+            if (index.empty() || index.back().label != label) {
+                index.push_back({label, 0, row});
+            }
+            index.back().count++;
+        }
+
+        // Layout ->
+        GalleryHeader header{};
+        std::memcpy(header.magic, GalleryHeader::magicValue, sizeof(header.magic));
+        header.version = GalleryHeader::currentVersion;
+        header.headerSize = sizeof(GalleryHeader);
+        header.dimension = dimension;
+        header.stride = stride;
+        header.count = count;
+        header.labelsOffset = sizeof(GalleryHeader);
+        header.descriptorsOffset = alignUp(header.labelsOffset + count * sizeof(std::int32_t),
+                                           GalleryHeader::alignment);
+        header.indexOffset = alignUp(header.descriptorsOffset + count * stride * sizeof(float),
+                                     GalleryHeader::alignment);
+        header.indexCount = index.size();
+        header.fileSize = alignUp(header.indexOffset + index.size() * sizeof(GalleryIndexEntry),
+                                  GalleryHeader::alignment);
+        // <- Layout
+
+        std::vector<char> data(header.fileSize, 0);
+
+        auto *labelsSection = reinterpret_cast<std::int32_t *>(data.data() + header.labelsOffset);
+        auto *descriptorsSection = reinterpret_cast<float *>(data.data() + header.descriptorsOffset);
+        for (std::size_t row = 0; row < count; ++row) {
+            labelsSection[row] = labels[order[row]];
+            auto const &descriptor = descriptors[order[row]];
+            std::copy(descriptor.begin(), descriptor.end(), descriptorsSection + row * stride);
+        }
+        std::memcpy(data.data() + header.indexOffset, index.data(), index.size() * sizeof(GalleryIndexEntry));
+
+        header.checksum = galleryChecksum(data.data() + sizeof(GalleryHeader),
+                                          data.size() - sizeof(GalleryHeader));
+        std::memcpy(data.data(), &header, sizeof(header));
+
+        return data;
+    }
+
+    bool saveGallery(std::string const &path, std::vector<int> const &labels,
+                     std::vector<std::vector<double>> const &descriptors) {
+        try {
+            std::vector<char> data = serializeGallery(labels, descriptors);
+
+            std::ofstream file(path, std::ios::binary);
+            file.exceptions(file.exceptions() | std::ofstream::failbit | std::ofstream::badbit);
+            file.write(data.data(), data.size());
+        } catch (std::exception &e) {
+            spdlog::error("Cannot save a gallery to '{}': {}", path, e.what());
+            return false;
+        }
+        return true;
+    }
+
+    MappedGallery::~MappedGallery() {
+        close();
+    }
+
+    bool MappedGallery::open(std::string const &path) {
+        int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd == -1) {
+            spdlog::error("Cannot open a gallery '{}': {}", path, strerror(errno));
+            close();
+            return false;
+        }
+
+        bool ok = map(fd, path);
+        ::close(fd);
+        return ok;
+    }
+
+    bool MappedGallery::map(int fd, std::string const &source) {
+        close();
+
+        struct stat st{};
+        if (fstat(fd, &st) == -1) {
+            spdlog::error("Cannot stat a gallery '{}': {}", source, strerror(errno));
+            return false;
+        }
+        if (st.st_size < static_cast<off_t>(sizeof(GalleryHeader))) {
+            spdlog::error("A gallery '{}' is too small", source);
+            return false;
+        }
+
+        void *addr = mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+        if (addr == MAP_FAILED) {
+            spdlog::error("Cannot map a gallery '{}': {}", source, strerror(errno));
+            return false;
+        }
+
+        _data = static_cast<char const *>(addr);
+        _size = st.st_size;
+        _mapped = true;
+
+        return _init(source);
+    }
+
+    bool MappedGallery::assign(std::vector<char> data) {
+        close();
+
+        _buffer = std::move(data);
+        _data = _buffer.empty() ? nullptr : _buffer.data();
+        _size = _buffer.size();
+        _mapped = false;
+
+        if (_size < sizeof(GalleryHeader)) {
+            spdlog::error("A gallery buffer is too small");
+            close();
+            return false;
+        }
+        return _init("<memory>");
+    }
+
+    void MappedGallery::close() {
+        if (_mapped && _data != nullptr) {
+            munmap(const_cast<char *>(_data), _size);
+        }
+        _buffer.clear();
+        _buffer.shrink_to_fit();
+
+        _data = nullptr;
+        _size = 0;
+        _mapped = false;
+        _header = nullptr;
+        _labels = nullptr;
+        _descriptors = nullptr;
+        _index = nullptr;
+
+        std::lock_guard lock(_validateMutex);
+        _validated = false;
+        _valid = false;
+    }
+
+    bool MappedGallery::validate() {
+        if (_validated.load(std::memory_order_acquire)) {
+            return _valid;
+        }
+
+        std::lock_guard lock(_validateMutex);
+        if (!_validated.load(std::memory_order_relaxed) && _data != nullptr) {
+            _valid = galleryChecksum(_data + _header->headerSize, _size - _header->headerSize) == _header->checksum;
+            _validated.store(true, std::memory_order_release);
+            if (!_valid) {
+                spdlog::error("A gallery checksum mismatch, the gallery is corrupted");
+            }
+        }
+        return _valid;
+    }
+
+    std::pair<std::size_t, std::size_t> MappedGallery::findLabel(int label) const {
+        auto [begin, end] = index();
+        auto it = std::lower_bound(begin, end, label,
+                                   [](GalleryIndexEntry const &entry, int l) { return entry.label < l; });
+        if (it == end || it->label != label) {
+            return {0, 0};
+        }
+        return {it->first, it->first + it->count};
+    }
+
+    bool MappedGallery::_init(std::string const &source) {
+        auto const *header = reinterpret_cast<GalleryHeader const *>(_data);
+
+        std::string error;
+        auto sectionFits = [&](std::uint64_t offset, std::uint64_t size) {
+            return offset % GalleryHeader::alignment == 0 && offset <= _size && size <= _size - offset;
+        };
+
+        if (std::memcmp(header->magic, GalleryHeader::magicValue, sizeof(header->magic)) != 0) {
+            error = "not a gallery file";
+        } else if (header->version != GalleryHeader::currentVersion) {
+            error = "unsupported version " + std::to_string(header->version);
+        } else if (header->headerSize < sizeof(GalleryHeader) || header->headerSize > _size
+                   || header->fileSize != _size) {
+            error = "size mismatch";
+        } else if (header->stride < header->dimension || header->stride % (GalleryHeader::alignment / sizeof(float))) {
+            error = "invalid stride";
+        } else if (!sectionFits(header->labelsOffset, header->count * sizeof(std::int32_t))
+                   || !sectionFits(header->descriptorsOffset, header->count * header->stride * sizeof(float))
+                   || (header->indexOffset != 0
+                       && !sectionFits(header->indexOffset, header->indexCount * sizeof(GalleryIndexEntry)))) {
+            error = "a section is out of bounds";
+        } else if (header->indexOffset != 0) {
+            // the rows of a label are read without checks, so all of them should be in the gallery
+            auto const *index = reinterpret_cast<GalleryIndexEntry const *>(_data + header->indexOffset);
+            for (std::uint64_t i = 0; i < header->indexCount && error.empty(); ++i) {
+                if (index[i].first > header->count || index[i].count > header->count - index[i].first) {
+                    error = "an index entry is out of bounds";
+                }
+            }
+        }
+
+        if (!error.empty()) {
+            spdlog::error("Cannot load a gallery '{}': {}", source, error);
+            close();
+            return false;
+        }
+
+        _header = header;
+        _labels = reinterpret_cast<std::int32_t const *>(_data + header->labelsOffset);
+        _descriptors = reinterpret_cast<float const *>(_data + header->descriptorsOffset);
+        _index = header->indexOffset != 0
+                 ? reinterpret_cast<GalleryIndexEntry const *>(_data + header->indexOffset) : nullptr;
+        return true;
+    }
+
+}
@@ -0,0 +1,231 @@
+/**
+ * @file GalleryFile.h
+ * @author Люнгрин Андрей aka prostoichelovek <iam.prostoi.chelovek@gmail.ru>
+ * @date 19 Oct 2026
+ * @copyright MIT License
+ *
+ * @brief This file contains a binary gallery file format, which can be memory-mapped and queried in place
+ */
+
+#ifndef FACES_GALLERYFILE_H
+#define FACES_GALLERYFILE_H
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <mutex>
+#include <utility>
+
+namespace faces {
+
+    /**
+     * A header of the gallery file. @n
+     * The file is little-endian and consists of the following sections,
+     * each of them starts at an offset aligned to @ref GalleryHeader::alignment bytes:
+     *  - this header;
+     *  - a label table - an int32 label of each descriptor;
+     *  - a descriptor matrix - `count` rows of float32 with `stride` values per row,
+     *    the padding after `dimension` values is filled with zeros;
+     *  - [optional] an index - a GalleryIndexEntry for each unique label, sorted by label.
+     *
+     * Rows of the descriptor matrix are sorted by label, so rows of each label are contiguous
+     */
+    struct GalleryHeader {
+        static constexpr char magicValue[8] = {'F', 'C', 'G', 'A', 'L', 'L', 'R', 'Y'};
+        static constexpr std::uint32_t currentVersion = 1;
+        static constexpr std::size_t alignment = 64;
+
+        char magic[8];
+        std::uint32_t version;
+        std::uint32_t headerSize;
+        std::uint32_t dimension;
+        std::uint32_t stride;
+        std::uint64_t count;
+        std::uint64_t labelsOffset;
+        std::uint64_t descriptorsOffset;
+        /// 0 if there is no index section
+        std::uint64_t indexOffset;
+        std::uint64_t indexCount;
+        std::uint64_t fileSize;
+        /// a checksum of everything after the header, see @ref galleryChecksum
+        std::uint64_t checksum;
+        std::uint8_t reserved[48];
+    };
+
+    static_assert(sizeof(GalleryHeader) == 2 * GalleryHeader::alignment,
+                  "GalleryHeader should occupy exactly two alignment blocks");
+
+    /**
+     * An entry of the gallery index: rows [first, first + count) of the descriptor matrix have the given label
+     */
+    struct GalleryIndexEntry {
+        std::int32_t label;
+        std::uint32_t count;
+        std::uint64_t first;
+    };
+
+    static_assert(sizeof(GalleryIndexEntry) == 16, "GalleryIndexEntry should not have any padding");
+
+    /**
+     * Computes a checksum (FNV-1a over 64-bit words) of the given data
+     *
+     * @param data - a pointer to the data; its size should be a multiple of 8
+     * @param size - size of the data in bytes
+     */
+    std::uint64_t galleryChecksum(char const *data, std::size_t size);
+
+    /**
+     * Serializes the given descriptors into the gallery file format
+     *
+     * @param labels      - a label of each descriptor
+     * @param descriptors - descriptors; all of them should have the same size
+     *
+     * @throws std::invalid_argument - if sizes of the labels and descriptors or descriptors themselves differ
+     *
+     * @return the content of a gallery file
+     */
+    std::vector<char> serializeGallery(std::vector<int> const &labels,
+                                       std::vector<std::vector<double>> const &descriptors);
+
+    /**
+     * Writes the given descriptors to a gallery file
+     *
+     * @see serializeGallery
+     *
+     * @return successfulness of the operation
+     */
+    bool saveGallery(std::string const &path, std::vector<int> const &labels,
+                     std::vector<std::vector<double>> const &descriptors);
+
+    /**
+     * A read-only view of the gallery, which is either memory-mapped from a file or owns its buffer. @n
+     * There is no parse step - only the header is checked on opening, and all of the queries
+     * are performed in place; the checksum is validated lazily, see @ref validate
+     */
+    class MappedGallery {
+    public:
+        MappedGallery() = default;
+
+        MappedGallery(MappedGallery const &) = delete;
+
+        MappedGallery &operator=(MappedGallery const &) = delete;
+
+        ~MappedGallery();
+
+        /**
+         * Memory-maps the given gallery file, closing the current one
+         *
+         * @return successfulness of the operation
+         */
+        bool open(std::string const &path);
+
+        /**
+         * Memory-maps a gallery from the given file descriptor (e.g. a file or a shared memory object)
+         *
+         * @param fd     - an opened file descriptor; it can be closed after the call
+         * @param source - a name of the source, used for logging
+         *
+         * @return successfulness of the operation
+         */
+        bool map(int fd, std::string const &source);
+
+        /**
+         * Takes ownership over the given content of a gallery file, closing the current one
+         *
+         * @return successfulness of the operation
+         */
+        bool assign(std::vector<char> data);
+
+        /**
+         * Unmaps / frees the current gallery
+         */
+        void close();
+
+        /**
+         * Validates the checksum of the gallery; the actual check is performed only once,
+         * and the following calls do not lock
+         *
+         * @return whether the gallery is intact
+         */
+        bool validate();
+
+        [[nodiscard]] bool isOpen() const {
+            return _data != nullptr;
+        }
+
+        [[nodiscard]] std::size_t dimension() const {
+            return _header->dimension;
+        }
+
+        [[nodiscard]] std::size_t stride() const {
+            return _header->stride;
+        }
+
+        [[nodiscard]] std::size_t size() const {
+            return _header->count;
+        }
+
+        [[nodiscard]] int label(std::size_t row) const {
+            return _labels[row];
+        }
+
+        /**
+         * @return a pointer to @ref stride floats of the descriptor at the given row
+         */
+        [[nodiscard]] float const *descriptor(std::size_t row) const {
+            return _descriptors + row * _header->stride;
+        }
+
+        /**
+         * @return the index section OR an empty range if the gallery does not have it
+         */
+        [[nodiscard]] std::pair<GalleryIndexEntry const *, GalleryIndexEntry const *> index() const {
+            return {_index, _index + (_index ? _header->indexCount : 0)};
+        }
+
+        /**
+         * Finds rows of the given label using the index section
+         *
+         * @return a range of rows [first, second) OR an empty range if the label or the index is not found
+         */
+        [[nodiscard]] std::pair<std::size_t, std::size_t> findLabel(int label) const;
+
+        /**
+         * @return the content of the gallery file
+         */
+        [[nodiscard]] std::pair<char const *, std::size_t> data() const {
+            return {_data, _size};
+        }
+
+    private:
+        char const *_data = nullptr;
+        std::size_t _size = 0;
+        /// whether @ref _data was mapped with mmap or belongs to @ref _buffer
+        bool _mapped = false;
+        std::vector<char> _buffer;
+
+        GalleryHeader const *_header = nullptr;
+        std::int32_t const *_labels = nullptr;
+        float const *_descriptors = nullptr;
+        GalleryIndexEntry const *_index = nullptr;
+
+        std::mutex _validateMutex;
+        /// whether @ref _valid is set; it is published after it, so it may be read without the mutex
+        std::atomic<bool> _validated = false;
+        bool _valid = false;
+
+        /**
+         * Checks the header of the current data and initializes section pointers
+         *
+         * @param source - a name of the source, used for logging
+         *
+         * @return whether the header is valid; closes the gallery if not
+         */
+        bool _init(std::string const &source);
+
+    };
+
+}
+
+#endif //FACES_GALLERYFILE_H
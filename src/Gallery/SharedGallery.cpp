@@ -0,0 +1,188 @@
+/**
+ * @file SharedGallery.cpp
+ * @author Люнгрин Андрей aka prostoichelovek <iam.prostoi.chelovek@gmail.ru>
+ * @date 19 Oct 2026
+ * @copyright MIT License
+ */
+
+#include "SharedGallery.h"
+
+#include <cstring>
+#include <cerrno>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+#include <spdlog/spdlog.h>
+
+namespace faces {
+
+    namespace {
+        std::string generationName(std::string const &name, std::uint64_t generation) {
+            return name + "." + std::to_string(generation);
+        }
+    }
+
+    SharedGalleryPublisher::SharedGalleryPublisher(std::string name) : _name(std::move(name)) {
+        int fd = shm_open(_name.c_str(), O_RDWR | O_CREAT, 0644);
+        if (fd == -1) {
+            spdlog::error("Cannot open a shared gallery control segment '{}': {}", _name, strerror(errno));
+            return;
+        }
+
+        void *addr = MAP_FAILED;
+        if (ftruncate(fd, sizeof(SharedGalleryControl)) == 0) {
+            addr = mmap(nullptr, sizeof(SharedGalleryControl), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        }
+        ::close(fd);
+        if (addr == MAP_FAILED) {
+            spdlog::error("Cannot map a shared gallery control segment '{}': {}", _name, strerror(errno));
+            return;
+        }
+
+        _control = static_cast<SharedGalleryControl *>(addr);
+        if (std::memcmp(_control->magic, SharedGalleryControl::magicValue, sizeof(_control->magic)) != 0
+            || _control->version != SharedGalleryControl::currentVersion) {
+            // a freshly created segment is zero-filled, so generation is already 0
+            std::memcpy(_control->magic, SharedGalleryControl::magicValue, sizeof(_control->magic));
+            _control->version = SharedGalleryControl::currentVersion;
+            _control->generation.store(0, std::memory_order_release);
+        }
+    }
+
+    SharedGalleryPublisher::~SharedGalleryPublisher() {
+        if (_control != nullptr) {
+            munmap(_control, sizeof(SharedGalleryControl));
+        }
+    }
+
+    bool SharedGalleryPublisher::publish(std::vector<char> const &gallery) {
+        if (_control == nullptr) {
+            return false;
+        }
+
+        std::uint64_t previous = _control->generation.load(std::memory_order_acquire);
+        std::uint64_t generation = previous + 1;
+        std::string segmentName = generationName(_name, generation);
+
+        // a leftover of a crashed publisher
+        shm_unlink(segmentName.c_str());
+
+        int fd = shm_open(segmentName.c_str(), O_RDWR | O_CREAT | O_EXCL, 0644);
+        if (fd == -1) {
+            spdlog::error("Cannot create a shared gallery segment '{}': {}", segmentName, strerror(errno));
+            return false;
+        }
+
+        void *addr = MAP_FAILED;
+        if (ftruncate(fd, gallery.size()) == 0) {
+            addr = mmap(nullptr, gallery.size(), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        }
+        ::close(fd);
+        if (addr == MAP_FAILED) {
+            spdlog::error("Cannot map a shared gallery segment '{}': {}", segmentName, strerror(errno));
+            shm_unlink(segmentName.c_str());
+            return false;
+        }
+
+        std::memcpy(addr, gallery.data(), gallery.size());
+        munmap(addr, gallery.size());
+
+        _control->generation.store(generation, std::memory_order_release);
+
+        if (previous > 1) {
+            shm_unlink(generationName(_name, previous - 1).c_str());
+        }
+
+        spdlog::info("Published a gallery generation {} to '{}'", generation, _name);
+        return true;
+    }
+
+    void SharedGalleryPublisher::unlink() {
+        if (_control == nullptr) {
+            return;
+        }
+
+        std::uint64_t generation = _control->generation.load(std::memory_order_acquire);
+        for (std::uint64_t g = generation > 1 ? generation - 1 : 1; g <= generation; ++g) {
+            shm_unlink(generationName(_name, g).c_str());
+        }
+        shm_unlink(_name.c_str());
+    }
+
+    SharedGalleryView::~SharedGalleryView() {
+        _detach();
+    }
+
+    void SharedGalleryView::_detach() {
+        if (_control != nullptr) {
+            munmap(const_cast<SharedGalleryControl *>(_control), sizeof(SharedGalleryControl));
+            _control = nullptr;
+        }
+    }
+
+    bool SharedGalleryView::attach(std::string const &name) {
+        int fd = shm_open(name.c_str(), O_RDONLY, 0);
+        if (fd == -1) {
+            spdlog::error("Cannot open a shared gallery control segment '{}': {}", name, strerror(errno));
+            return false;
+        }
+
+        void *addr = mmap(nullptr, sizeof(SharedGalleryControl), PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (addr == MAP_FAILED) {
+            spdlog::error("Cannot map a shared gallery control segment '{}': {}", name, strerror(errno));
+            return false;
+        }
+
+        auto const *control = static_cast<SharedGalleryControl const *>(addr);
+        if (std::memcmp(control->magic, SharedGalleryControl::magicValue, sizeof(control->magic)) != 0
+            || control->version != SharedGalleryControl::currentVersion) {
+            spdlog::error("'{}' is not a shared gallery control segment", name);
+            munmap(addr, sizeof(SharedGalleryControl));
+            return false;
+        }
+
+        _detach();
+        _name = name;
+        _control = control;
+        _generation = 0;
+        _failedGeneration = 0;
+        _gallery.reset();
+        return true;
+    }
+
+    std::shared_ptr<MappedGallery> SharedGalleryView::refresh() {
+        if (_control == nullptr) {
+            return nullptr;
+        }
+
+        std::uint64_t generation = _control->generation.load(std::memory_order_acquire);
+        if (generation == _generation || generation == _failedGeneration) {
+            return _gallery;
+        }
+
+        std::string segmentName = generationName(_name, generation);
+        int fd = shm_open(segmentName.c_str(), O_RDONLY, 0);
+        if (fd == -1) {
+            spdlog::error("Cannot open a shared gallery segment '{}': {}", segmentName, strerror(errno));
+            _failedGeneration = generation;
+            return _gallery;
+        }
+
+        auto gallery = std::make_shared<MappedGallery>();
+        bool ok = gallery->map(fd, segmentName);
+        ::close(fd);
+        if (!ok) {
+            _failedGeneration = generation;
+            return _gallery;
+        }
+
+        _generation = generation;
+        _gallery = gallery;
+        spdlog::info("Attached to a gallery generation {} of '{}'", generation, _name);
+        return _gallery;
+    }
+
+}
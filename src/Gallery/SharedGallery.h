@@ -0,0 +1,140 @@
+/**
+ * @file SharedGallery.h
+ * @author Люнгрин Андрей aka prostoichelovek <iam.prostoi.chelovek@gmail.ru>
+ * @date 19 Oct 2026
+ * @copyright MIT License
+ *
+ * @brief This file contains classes to publish a gallery into POSIX shared memory and to attach to it
+ */
+
+#ifndef FACES_SHAREDGALLERY_H
+#define FACES_SHAREDGALLERY_H
+
+#include <atomic>
+#include <memory>
+
+#include "GalleryFile.h"
+
+namespace faces {
+
+    /**
+     * A control segment of the shared gallery. @n
+     * Galleries themselves are published into separate segments named `[name].[generation]`,
+     * and the control segment `[name]` contains a number of the current generation,
+     * so readers pick up a new gallery atomically
+     */
+    struct SharedGalleryControl {
+        static constexpr char magicValue[8] = {'F', 'C', 'G', 'A', 'L', 'C', 'T', 'L'};
+        static constexpr std::uint32_t currentVersion = 1;
+
+        char magic[8];
+        std::uint32_t version;
+        std::uint32_t reserved;
+        /// 0 if nothing was published yet
+        std::atomic<std::uint64_t> generation;
+    };
+
+    static_assert(std::atomic<std::uint64_t>::is_always_lock_free,
+                  "The shared gallery generation should be lock-free to be used across processes");
+
+    /**
+     * Publishes galleries into the POSIX shared memory; there should be only one publisher for a name
+     */
+    class SharedGalleryPublisher {
+    public:
+        /**
+         * Creates or opens a control segment with the given name
+         *
+         * @param name - a name of the shared gallery, it should start with '/' (e.g. "/faces")
+         */
+        explicit SharedGalleryPublisher(std::string name);
+
+        SharedGalleryPublisher(SharedGalleryPublisher const &) = delete;
+
+        SharedGalleryPublisher &operator=(SharedGalleryPublisher const &) = delete;
+
+        ~SharedGalleryPublisher();
+
+        /**
+         * Publishes the given gallery as a new generation. @n
+         * The previous generation is kept for readers which are attaching right now,
+         * all of the older ones are unlinked; readers, which have already mapped them, are not affected
+         *
+         * @param gallery - the content of a gallery file (see @ref serializeGallery)
+         *
+         * @return successfulness of the operation
+         */
+        bool publish(std::vector<char> const &gallery);
+
+        /**
+         * Removes the control segment and the remaining generations from the shared memory
+         */
+        void unlink();
+
+        [[nodiscard]] bool isOk() const {
+            return _control != nullptr;
+        }
+
+    private:
+        const std::string _name;
+        SharedGalleryControl *_control = nullptr;
+
+    };
+
+    /**
+     * A read-only view of the shared gallery, which follows the published generations
+     */
+    class SharedGalleryView {
+    public:
+        SharedGalleryView() = default;
+
+        SharedGalleryView(SharedGalleryView const &) = delete;
+
+        SharedGalleryView &operator=(SharedGalleryView const &) = delete;
+
+        ~SharedGalleryView();
+
+        /**
+         * Attaches to the control segment of the shared gallery with the given name,
+         * detaching from the previous one
+         *
+         * @return successfulness of the operation
+         */
+        bool attach(std::string const &name);
+
+        /**
+         * Maps the current generation of the gallery if it has changed since the last call;
+         * it costs a single atomic load if nothing has changed
+         *
+         * @return the current gallery OR nullptr if nothing was published yet or it cannot be mapped
+         */
+        std::shared_ptr<MappedGallery> refresh();
+
+        /**
+         * @return the last published generation, which may be not mapped yet; it is safe to call concurrently
+         */
+        [[nodiscard]] std::uint64_t getPublishedGeneration() const {
+            return _control != nullptr ? _control->generation.load(std::memory_order_acquire) : 0;
+        }
+
+        [[nodiscard]] bool isAttached() const {
+            return _control != nullptr;
+        }
+
+    private:
+        std::string _name;
+        SharedGalleryControl const *_control = nullptr;
+
+        std::uint64_t _generation = 0;
+        std::shared_ptr<MappedGallery> _gallery;
+
+        /// the last generation, which could not be mapped, so the error is reported once
+        std::uint64_t _failedGeneration = 0;
+
+        void _detach();
+
+    };
+
+}
+
+#endif //FACES_SHAREDGALLERY_H
@@ -12,6 +12,7 @@
 
 
 #include <Face/Face.h>
+#include <utils/Async.hpp>
 
 namespace faces {
 
@@ -42,6 +43,21 @@ namespace faces {
             }
         }
 
+        /**
+         * Detects landmarks of the given faces on the ThreadPool;
+         * the asynchronous calls of a landmarker run one at a time in the order of the calls
+         *
+         * @param faces - faces, detect landmarks for the image of which
+         *
+         * @return a future of the faces with their landmarks
+         */
+        Future<std::vector<Face>> detectAsync(std::vector<Face> faces) {
+            return _strand.run([this, faces]() mutable {
+                detect(faces);
+                return std::move(faces);
+            });
+        }
+
         /**
          * @return a value of the @ref _ok flag
          */
@@ -53,6 +69,9 @@ namespace faces {
         /// the flag which indicates the readiness of the detector
         bool _ok = false;
 
+        /// runs the asynchronous calls one at a time
+        Strand _strand;
+
         /**
          * Detects landmarks for the face on the given image
          *
@@ -0,0 +1,253 @@
+/**
+ * @file MultiStreamRuntime.cpp
+ * @author Люнгрин Андрей aka prostoichelovek <iam.prostoi.chelovek@gmail.ru>
+ * @date 19 Oct 2026
+ * @copyright MIT License
+ */
+
+#include "MultiStreamRuntime.h"
+
+namespace faces {
+
+    namespace {
+
+        /**
+         * Wraps the components into the shared instances, which are checked to be ready
+         *
+         * @return whether all of the components are ready
+         */
+        template<typename Instance, typename Component>
+        bool makeInstances(std::vector<Component *> const &components, std::vector<Instance> &instances) {
+            for (Component *component : components) {
+                if (component == nullptr || !component->isOk()) {
+                    return false;
+                }
+                instances.push_back({component});
+            }
+            return true;
+        }
+
+    }
+
+    MultiStreamRuntime::MultiStreamRuntime(Pipeline::Components components, Config const &config) {
+        int workersCount = 0;
+        try {
+            workersCount = config["MultiStreamRuntime.workers"].getInt();
+            _batchSize = config["MultiStreamRuntime.batchSize"].getInt();
+            _queueSize = config["MultiStreamRuntime.queueSize"].getInt();
+            _trackMaxMisses = std::max(0, config["TrackManager.maxMisses"].getInt());
+            std::string policy = config["MultiStreamRuntime.overflowPolicy"].getString();
+            if (std::optional<OverflowPolicy> overflowPolicy = getOverflowPolicy(policy)) {
+                _overflowPolicy = *overflowPolicy;
+            } else {
+                spdlog::error("Unknown overflow policy of the MultiStreamRuntime: {}", policy);
+            }
+        } catch (std::out_of_range &e) {
+            spdlog::error("Cannot get parameters of the MultiStreamRuntime from the config, using the default ones");
+        }
+
+        bool isReady = makeInstances(components.detectors, _detectors)
+                       && makeInstances(components.landmarkers, _landmarkers)
+                       && makeInstances(components.aligners, _aligners)
+                       && makeInstances(components.qualityEstimators, _qualityEstimators)
+                       && makeInstances(components.recognizers, _recognizers);
+        if (!isReady) {
+            spdlog::error("Some component of the MultiStreamRuntime is not ready");
+            return;
+        }
+
+        _workersCount = workersCount > 0 ? workersCount : std::max<std::size_t>(_detectors.size(), 1);
+        for (std::size_t i = 0; i < _workersCount; ++i) {
+            _workers.emplace_back(&MultiStreamRuntime::_run, this, i);
+        }
+
+        _ok = true;
+    }
+
+    MultiStreamRuntime::~MultiStreamRuntime() {
+        _isStopping = true;
+        // the consumers waiting in next() and the producers blocked in submit() are woken up
+        {
+            std::lock_guard<std::mutex> lock(_streamsMutex);
+            for (std::shared_ptr<Stream> const &stream : _streams) {
+                stream->input.close();
+                stream->output.close();
+            }
+        }
+        for (std::thread &worker : _workers) {
+            worker.join();
+        }
+    }
+
+    MultiStreamRuntime::StreamId MultiStreamRuntime::addStream(Tracker *tracker) {
+        auto stream = std::make_shared<Stream>(std::max<std::size_t>(_queueSize, 1));
+        if (tracker != nullptr) {
+            stream->tracks = std::make_unique<TrackManager>(tracker, _trackMaxMisses);
+        }
+
+        std::lock_guard<std::mutex> lock(_streamsMutex);
+        _streams.emplace_back(std::move(stream));
+        return _streams.size() - 1;
+    }
+
+    bool MultiStreamRuntime::submit(StreamId id, Frame frame) {
+        std::shared_ptr<Stream> stream = _getStream(id);
+        if (!_ok || stream == nullptr) {
+            return false;
+        }
+
+        ++stream->submitted;
+        return stream->input.push(std::move(frame), _overflowPolicy, [&stream](Frame &) { ++stream->dropped; });
+    }
+
+    bool MultiStreamRuntime::next(StreamId id, Frame &frame) {
+        std::shared_ptr<Stream> stream = _getStream(id);
+        return stream != nullptr && stream->output.pop(frame);
+    }
+
+    bool MultiStreamRuntime::tryNext(StreamId id, Frame &frame) {
+        std::shared_ptr<Stream> stream = _getStream(id);
+        return stream != nullptr && stream->output.tryPop(frame);
+    }
+
+    void MultiStreamRuntime::closeStream(StreamId id) {
+        if (std::shared_ptr<Stream> stream = _getStream(id)) {
+            stream->input.close();
+        }
+    }
+
+    MultiStreamRuntime::StreamStats MultiStreamRuntime::getStats(StreamId id) const {
+        std::shared_ptr<Stream> stream = _getStream(id);
+        if (stream == nullptr) {
+            return {};
+        }
+
+        return {stream->submitted, stream->processed, stream->dropped, stream->input.size(), stream->fps};
+    }
+
+    std::size_t MultiStreamRuntime::getStreamsCount() const {
+        std::lock_guard<std::mutex> lock(_streamsMutex);
+        return _streams.size();
+    }
+
+    void MultiStreamRuntime::_run(std::size_t worker) {
+        std::vector<std::shared_ptr<Stream>> streams;
+        std::vector<Frame> frames;
+
+        Backoff backoff;
+        while (!_isStopping) {
+            _takeBatch(streams, frames);
+            if (frames.empty()) {
+                backoff.wait();
+                continue;
+            }
+            backoff.reset();
+
+            _process(worker, frames);
+
+            for (std::size_t i = 0; i < frames.size(); ++i) {
+                _deliver(*streams[i], frames[i]);
+                streams[i]->isBusy = false;
+            }
+        }
+    }
+
+    void MultiStreamRuntime::_takeBatch(std::vector<std::shared_ptr<Stream>> &streams, std::vector<Frame> &frames) {
+        streams.clear();
+        frames.clear();
+
+        std::lock_guard<std::mutex> lock(_streamsMutex);
+        std::size_t count = _streams.size();
+        for (std::size_t i = 0; i < count && frames.size() < std::max<std::size_t>(_batchSize, 1); ++i) {
+            std::size_t idx = (_nextStream + i) % count;
+            std::shared_ptr<Stream> const &stream = _streams[idx];
+
+            if (stream->isBusy.exchange(true)) continue;
+
+            Frame frame;
+            if (stream->input.tryPop(frame)) {
+                streams.emplace_back(stream);
+                frames.emplace_back(std::move(frame));
+                // the next batch starts after the last served stream
+                _nextStream = idx + 1;
+            } else {
+                // nothing comes after the closed and empty input
+                if (stream->input.isClosed() && !stream->output.isClosed() && stream->input.size() == 0) {
+                    stream->output.close();
+                }
+                stream->isBusy = false;
+            }
+        }
+    }
+
+    void MultiStreamRuntime::_process(std::size_t worker, std::vector<Frame> &frames) {
+        _use(_detectors, worker, [&frames](Detector &detector) {
+            std::vector<cv::Mat> imgs;
+            for (Frame const &frame : frames) {
+                imgs.emplace_back(frame.img);
+            }
+
+            std::vector<std::vector<Face>> detected = detector.detect(imgs);
+            for (std::size_t i = 0; i < frames.size() && i < detected.size(); ++i) {
+                frames[i].faces = std::move(detected[i]);
+            }
+        });
+
+        _use(_landmarkers, worker, [&frames](Landmarker &landmarker) {
+            for (Frame &frame : frames) {
+                landmarker.detect(frame.faces);
+            }
+        });
+
+        _use(_aligners, worker, [&frames](Aligner &aligner) {
+            for (Frame &frame : frames) {
+                aligner.align(frame.faces, frame.img);
+            }
+        });
+
+        _use(_qualityEstimators, worker, [&frames](QualityEstimator &estimator) {
+            for (Frame &frame : frames) {
+                estimator.estimate(frame.faces);
+            }
+        });
+
+        // the faces of all of the frames are recognized as a single batch
+        _use(_recognizers, worker, [&frames](Recognizer &recognizer) {
+            std::vector<Face> faces;
+            for (Frame &frame : frames) {
+                std::move(frame.faces.begin(), frame.faces.end(), std::back_inserter(faces));
+            }
+
+            recognizer.recognize(faces);
+
+            auto face = faces.begin();
+            for (Frame &frame : frames) {
+                std::move(face, face + frame.faces.size(), frame.faces.begin());
+                face += frame.faces.size();
+            }
+        });
+    }
+
+    void MultiStreamRuntime::_deliver(Stream &stream, Frame &frame) {
+        if (stream.tracks != nullptr) {
+            stream.tracks->update(frame.faces, frame.img);
+        }
+
+        stream.output.push(std::move(frame), OverflowPolicy::DropOldest, [&stream](Frame &) { ++stream.dropped; });
+        ++stream.processed;
+
+        ++stream.windowFrames;
+        std::chrono::duration<double> elapsed = Clock::now() - stream.windowStart;
+        if (elapsed.count() >= 1) {
+            stream.fps = stream.windowFrames / elapsed.count();
+            stream.windowStart = Clock::now();
+            stream.windowFrames = 0;
+        }
+    }
+
+    std::shared_ptr<MultiStreamRuntime::Stream> MultiStreamRuntime::_getStream(StreamId id) const {
+        std::lock_guard<std::mutex> lock(_streamsMutex);
+        return id < _streams.size() ? _streams[id] : nullptr;
+    }
+
+}
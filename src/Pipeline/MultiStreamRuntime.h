@@ -0,0 +1,243 @@
+/**
+ * @file MultiStreamRuntime.h
+ * @author Люнгрин Андрей aka prostoichelovek <iam.prostoi.chelovek@gmail.ru>
+ * @date 19 Oct 2026
+ * @copyright MIT License
+ *
+ * @brief This file contains a runtime, which processes many streams with a shared set of components
+ */
+
+#ifndef FACES_MULTISTREAMRUNTIME_H
+#define FACES_MULTISTREAMRUNTIME_H
+
+#include "Pipeline.h"
+
+namespace faces {
+
+    /**
+     * A runtime, which processes the frames of many streams on a fixed pool of workers
+     * sharing the same component instances, so adding a stream does not load the models again. @n
+     * Each worker takes the frames of up to `batchSize` different streams in the round-robin order,
+     * so every stream gets its share, and runs the components on them as a batch:
+     * the frames are detected in a single call and the faces of all of the frames are recognized together. @n
+     * A worker uses the i-th instance of each component modulo their number, and an instance used by
+     * several workers is locked. A stream is processed by a single worker at a time,
+     * so its frames stay in order and it may be tracked
+     */
+    class MultiStreamRuntime {
+    public:
+        using StreamId = std::size_t;
+
+        using Frame = Pipeline::Frame;
+
+        using Clock = Pipeline::Clock;
+
+        /**
+         * Statistics of a stream
+         */
+        struct StreamStats {
+            std::size_t submitted = 0;
+            std::size_t processed = 0;
+            /// frames dropped by the overflow policy of the input queue or not taken from the output one
+            std::size_t dropped = 0;
+            /// a number of frames waiting in the input queue
+            std::size_t queueDepth = 0;
+            /// processed frames per second during the last second
+            double fps = 0;
+        };
+
+        /**
+         * Starts the workers
+         *
+         * @param components - the components shared by the streams; the tracks and the TrackedRecognizer
+         *                     are not used, since they are specific to a stream
+         * @param config     - a config with the number of workers, the batch size and the queues parameters
+         */
+        MultiStreamRuntime(Pipeline::Components components, Config const &config);
+
+        /**
+         * Closes the queues of all of the streams and stops the workers discarding the frames,
+         * which are not processed yet
+         */
+        ~MultiStreamRuntime();
+
+        MultiStreamRuntime(MultiStreamRuntime const &) = delete;
+
+        MultiStreamRuntime &operator=(MultiStreamRuntime const &) = delete;
+
+        /**
+         * Adds a new stream
+         *
+         * @param tracker - a tracker of the faces of the stream OR nullptr to not track them;
+         *                  it is not owned by this class, and it should not be shared with other streams
+         *
+         * @return an id of the stream
+         */
+        StreamId addStream(Tracker *tracker = nullptr);
+
+        /**
+         * Puts the frame of the stream into the runtime
+         *
+         * @return whether the frame was accepted, or it was dropped because the input queue of the stream is full
+         */
+        bool submit(StreamId id, Frame frame);
+
+        /**
+         * Takes the next processed frame of the stream waiting for it
+         *
+         * @return false if the stream is closed and all of its frames are taken OR the stream does not exist
+         */
+        bool next(StreamId id, Frame &frame);
+
+        /**
+         * Takes the next processed frame of the stream if it is ready
+         *
+         * @return whether a frame was taken
+         */
+        bool tryNext(StreamId id, Frame &frame);
+
+        /**
+         * Tells the runtime, that there will be no more frames of the stream;
+         * the submitted ones are still processed
+         */
+        void closeStream(StreamId id);
+
+        /**
+         * @return statistics of the stream OR empty statistics if the stream does not exist
+         */
+        [[nodiscard]] StreamStats getStats(StreamId id) const;
+
+        [[nodiscard]] std::size_t getStreamsCount() const;
+
+        [[nodiscard]] bool isOk() const {
+            return _ok;
+        }
+
+    protected:
+        /**
+         * A stream with its queues, tracks and statistics
+         */
+        struct Stream {
+            BoundedQueue<Frame> input;
+            BoundedQueue<Frame> output;
+
+            std::unique_ptr<TrackManager> tracks;
+
+            /// whether some worker processes a frame of the stream
+            std::atomic<bool> isBusy = false;
+
+            std::atomic<std::size_t> submitted = 0;
+            std::atomic<std::size_t> processed = 0;
+            std::atomic<std::size_t> dropped = 0;
+
+            /// the processed frames per second, which is updated once a second
+            std::atomic<double> fps = 0;
+            Clock::time_point windowStart = Clock::now();
+            std::size_t windowFrames = 0;
+
+            explicit Stream(std::size_t queueSize)
+                    : input(queueSize), output(queueSize) {}
+        };
+
+        /**
+         * A component instance shared by the workers
+         */
+        template<typename Component>
+        struct Instance {
+            Component *component;
+            std::unique_ptr<std::mutex> mutex = std::make_unique<std::mutex>();
+        };
+
+        bool _ok = false;
+
+        std::vector<Instance<Detector>> _detectors;
+        std::vector<Instance<Landmarker>> _landmarkers;
+        std::vector<Instance<Aligner>> _aligners;
+        std::vector<Instance<QualityEstimator>> _qualityEstimators;
+        std::vector<Instance<Recognizer>> _recognizers;
+
+        std::size_t _workersCount = 0;
+        std::size_t _batchSize = 8;
+        std::size_t _queueSize = 4;
+        /// a number of frames the tracks of the streams are kept without their faces
+        std::size_t _trackMaxMisses = 5;
+        OverflowPolicy _overflowPolicy = OverflowPolicy::DropOldest;
+
+        /// the streams, which are never removed, so their ids are their indexes
+        std::vector<std::shared_ptr<Stream>> _streams;
+        mutable std::mutex _streamsMutex;
+
+        /// a stream to start the next batch from
+        std::size_t _nextStream = 0;
+
+        std::atomic<bool> _isStopping = false;
+
+        std::vector<std::thread> _workers;
+
+        /**
+         * Runs a worker
+         *
+         * @param worker - an index of the worker
+         */
+        void _run(std::size_t worker);
+
+        /**
+         * Takes a frame from each of the free streams in the round-robin order up to the batch size
+         *
+         * @param streams - a destination of the streams of the frames, which are marked busy
+         * @param frames  - a destination of the frames
+         */
+        void _takeBatch(std::vector<std::shared_ptr<Stream>> &streams, std::vector<Frame> &frames);
+
+        /**
+         * Runs the shared components on the frames
+         *
+         * @param worker - an index of the worker, which selects the instances
+         * @param frames - the frames to process
+         */
+        void _process(std::size_t worker, std::vector<Frame> &frames);
+
+        /**
+         * Tracks the processed frame and puts it into the output queue of its stream
+         */
+        void _deliver(Stream &stream, Frame &frame);
+
+        /**
+         * @return the stream with the given id OR nullptr if it does not exist
+         */
+        [[nodiscard]] std::shared_ptr<Stream> _getStream(StreamId id) const;
+
+        /**
+         * Calls the function with the instance of the worker holding its lock
+         */
+        template<typename Component, typename Function>
+        static void _use(std::vector<Instance<Component>> &instances, std::size_t worker, Function function) {
+            if (instances.empty()) {
+                return;
+            }
+
+            Instance<Component> &instance = instances[worker % instances.size()];
+            std::lock_guard<std::mutex> lock(*instance.mutex);
+            function(*instance.component);
+        }
+
+    };
+
+    FACES_AUGMENT_CONFIG(MultiStreamRuntime,
+                         FACES_ADD_CONFIG_OPTION("MultiStreamRuntime.workers", "streamWorkers", 0, false,
+                                                 "A number of workers processing the streams; "
+                                                 "0 to use one per detector")
+                                 FACES_ADD_CONFIG_OPTION("MultiStreamRuntime.batchSize", "streamBatchSize", 8,
+                                                         false, "A maximal number of frames of different streams "
+                                                                "processed together")
+                                 FACES_ADD_CONFIG_OPTION("MultiStreamRuntime.queueSize", "streamQueueSize", 4,
+                                                         false, "A capacity of the queues of each stream")
+                                 FACES_ADD_CONFIG_OPTION("MultiStreamRuntime.overflowPolicy",
+                                                         "streamOverflowPolicy", "dropOldest", false,
+                                                         "What to do with a new frame when the queue of its "
+                                                         "stream is full: block, dropOldest or dropNewest")
+    )
+
+}
+
+#endif //FACES_MULTISTREAMRUNTIME_H
@@ -0,0 +1,355 @@
+/**
+ * @file Pipeline.cpp
+ * @author Люнгрин Андрей aka prostoichelovek <iam.prostoi.chelovek@gmail.ru>
+ * @date 19 Oct 2026
+ * @copyright MIT License
+ */
+
+#include "Pipeline.h"
+
+#include <sstream>
+
+namespace faces {
+
+    namespace {
+
+        /**
+         * Creates a processor for each of the components, which are checked to be ready
+         *
+         * @return the processors OR an empty vector if some component is not ready
+         */
+        template<typename Component, typename Process>
+        std::vector<std::function<void(Pipeline::Frame &)>> makeProcessors(std::vector<Component *> const &components,
+                                                                           Process process) {
+            std::vector<std::function<void(Pipeline::Frame &)>> res;
+            for (Component *component : components) {
+                if (component == nullptr || !component->isOk()) {
+                    return {};
+                }
+                res.emplace_back([component, process](Pipeline::Frame &frame) { process(*component, frame); });
+            }
+            return res;
+        }
+
+    }
+
+    Pipeline::Pipeline(Components components, Config const &config)
+            : _components(std::move(components)) {
+        try {
+            _queueSize = config["Pipeline.queueSize"].getInt();
+            std::string policy = config["Pipeline.overflowPolicy"].getString();
+            if (std::optional<OverflowPolicy> overflowPolicy = getOverflowPolicy(policy)) {
+                _overflowPolicy = *overflowPolicy;
+            } else {
+                spdlog::error("Unknown overflow policy of the Pipeline: {}", policy);
+            }
+            _deadline = config["Pipeline.deadline"].getNumber();
+            _parseStageCpus(config["Pipeline.stageCpus"].getString());
+        } catch (std::out_of_range &e) {
+            spdlog::error("Cannot get parameters of the Pipeline from the config, using the default ones");
+        }
+
+        struct StageProcessors {
+            std::string name;
+            bool isOptional;
+            std::size_t componentsCount;
+            std::vector<Processor> processors;
+        };
+        // the alignment and the later stages are needed only for the recognition
+        std::vector<StageProcessors> stages{
+                {"detection", false, _components.detectors.size(),
+                 makeProcessors(_components.detectors, [](Detector &detector, Frame &frame) {
+                     frame.faces = detector.detect(frame.img);
+                 })},
+                {"landmarks", false, _components.landmarkers.size(),
+                 makeProcessors(_components.landmarkers, [](Landmarker &landmarker, Frame &frame) {
+                     landmarker.detect(frame.faces);
+                 })},
+                {"alignment", true, _components.aligners.size(),
+                 makeProcessors(_components.aligners, [](Aligner &aligner, Frame &frame) {
+                     aligner.align(frame.faces, frame.img);
+                 })},
+                {"quality", true, _components.qualityEstimators.size(),
+                 makeProcessors(_components.qualityEstimators, [](QualityEstimator &estimator, Frame &frame) {
+                     estimator.estimate(frame.faces);
+                 })},
+                {"recognition", true, _components.recognizers.size(),
+                 makeProcessors(_components.recognizers, [](Recognizer &recognizer, Frame &frame) {
+                     recognizer.recognize(frame.faces);
+                 })},
+        };
+        for (StageProcessors const &stage : stages) {
+            if (stage.processors.size() != stage.componentsCount) {
+                spdlog::error("Some component of the {} stage of the Pipeline is not ready", stage.name);
+                return;
+            }
+        }
+        if (_components.trackedRecognizer != nullptr && _components.tracks == nullptr) {
+            spdlog::error("The TrackedRecognizer of the Pipeline requires the TrackManager");
+            return;
+        }
+
+        stages.erase(std::remove_if(stages.begin(), stages.end(),
+                                    [](StageProcessors const &stage) { return stage.processors.empty(); }),
+                     stages.end());
+
+        // the parallel stages, the ordered one and the output
+        for (std::size_t i = 0; i < stages.size() + 2; ++i) {
+            _queues.emplace_back(std::make_unique<Queue>(std::max<std::size_t>(_queueSize, 1)));
+        }
+        for (StageProcessors const &stage : stages) {
+            _stages.emplace_back(std::make_unique<Stage>());
+            _stages.back()->name = stage.name;
+            _stages.back()->isOptional = stage.isOptional;
+            _stages.back()->runningWorkers = stage.processors.size();
+        }
+        _stages.emplace_back(std::make_unique<Stage>());
+        _stages.back()->name = "tracking";
+        _stages.back()->runningWorkers = 1;
+
+        for (std::size_t stage = 0; stage < stages.size(); ++stage) {
+            for (Processor &processor : stages[stage].processors) {
+                _workers.emplace_back(&Pipeline::_runStage, this, stage, std::move(processor));
+            }
+        }
+        _workers.emplace_back(&Pipeline::_runOrdered, this);
+
+        _ok = true;
+    }
+
+    Pipeline::~Pipeline() {
+        if (_queues.empty()) {
+            return;
+        }
+
+        // closing the output makes the workers discard the results instead of waiting for them to be taken
+        _queues.front()->close();
+        _queues.back()->close();
+        for (std::thread &worker : _workers) {
+            worker.join();
+        }
+    }
+
+    bool Pipeline::submit(Frame frame) {
+        if (!_ok) {
+            return false;
+        }
+
+        ++_submittedCount;
+        Item item{_nextSequence++, std::move(frame)};
+        return _queues.front()->push(std::move(item), _overflowPolicy, [this](Item &dropped) {
+            // the input queue is full, so the marker goes straight to the ordered stage
+            _queues[_queues.size() - 2]->push({dropped.sequence, {}, true});
+            ++_droppedCount;
+        });
+    }
+
+    bool Pipeline::next(Frame &frame) {
+        Item item;
+        if (!_ok || !_queues.back()->pop(item)) {
+            return false;
+        }
+
+        frame = std::move(item.frame);
+        return true;
+    }
+
+    bool Pipeline::tryNext(Frame &frame) {
+        Item item;
+        if (!_ok || !_queues.back()->tryPop(item)) {
+            return false;
+        }
+
+        frame = std::move(item.frame);
+        return true;
+    }
+
+    void Pipeline::close() {
+        if (!_queues.empty()) {
+            _queues.front()->close();
+        }
+    }
+
+    void Pipeline::_parseStageCpus(std::string const &stageCpus) {
+        std::stringstream stream(stageCpus);
+        std::string entry;
+        while (std::getline(stream, entry, ';')) {
+            if (entry.empty()) continue;
+
+            std::size_t colon = entry.find(':');
+            std::vector<int> cpus;
+            if (colon != std::string::npos) {
+                cpus = parseCpuList(entry.substr(colon + 1));
+            }
+            if (cpus.empty()) {
+                spdlog::error("Malformed CPUs of a stage of the Pipeline: {}", entry);
+                continue;
+            }
+            _stageCpus[entry.substr(0, colon)] = std::move(cpus);
+        }
+    }
+
+    void Pipeline::_pin(std::string const &stage) const {
+        auto cpus = _stageCpus.find(stage);
+        if (cpus != _stageCpus.end() && !setThreadAffinity(cpus->second)) {
+            spdlog::warn("Cannot pin a worker of the {} stage of the Pipeline to the CPUs", stage);
+        }
+    }
+
+    void Pipeline::_runStage(std::size_t stage, Processor const &processor) {
+        Queue &input = *_queues[stage];
+        Queue &output = *_queues[stage + 1];
+        Stage &state = *_stages[stage];
+        _pin(state.name);
+
+        Item item;
+        while (input.pop(item)) {
+            // the markers of the dropped frames are only passed on to the ordered stage
+            if (!item.isDropped) {
+                Decision decision = _schedule(stage, item.frame);
+                if (decision == Decision::Drop) {
+                    item.frame = Frame();
+                    item.isDropped = true;
+                    ++state.dropped;
+                } else if (decision == Decision::Skip) {
+                    item.frame.isDegraded = true;
+                    ++state.skipped;
+                } else {
+                    _measure(state, [&processor, &item]() { processor(item.frame); });
+                }
+            }
+
+            // it fails only when the pipeline is being destroyed
+            output.push(std::move(item));
+        }
+
+        if (--state.runningWorkers == 0) {
+            output.close();
+        }
+    }
+
+    void Pipeline::_runOrdered() {
+        Queue &input = *_queues[_queues.size() - 2];
+        _pin(_stages.back()->name);
+
+        // the frames and the markers of the dropped ones, which came before the previous ones
+        std::map<std::size_t, Item> pending;
+        std::size_t expected = 0;
+        auto flush = [&](bool isFinal) {
+            while (true) {
+                if (!pending.empty() && pending.begin()->first == expected) {
+                    if (!pending.begin()->second.isDropped) {
+                        _deliver(pending.begin()->second.frame);
+                    }
+                    pending.erase(pending.begin());
+                    ++expected;
+                } else if (isFinal && !pending.empty()) {
+                    expected = pending.begin()->first;
+                } else {
+                    break;
+                }
+            }
+        };
+
+        Item item;
+        while (input.pop(item)) {
+            pending.emplace(item.sequence, std::move(item));
+            flush(false);
+        }
+        flush(true);
+
+        _queues.back()->close();
+    }
+
+    void Pipeline::_deliver(Frame &frame) {
+        Stage &state = *_stages.back();
+
+        // the frames are delivered even if they are late, since the tracks should see all of them
+        if (_schedule(_stages.size() - 1, frame) != Decision::Process) {
+            frame.isDegraded = true;
+        }
+
+        _measure(state, [this, &frame]() {
+            if (_components.tracks == nullptr) {
+                return;
+            }
+
+            _components.tracks->update(frame.faces, frame.img);
+            if (frame.isDegraded) {
+                for (Face &face : frame.faces) {
+                    if (TrackInfo const *track = _components.tracks->get(face.trackId)) {
+                        face.label = track->label;
+                    }
+                }
+            }
+        });
+        if (_components.tracks != nullptr && _components.trackedRecognizer != nullptr && !frame.isDegraded) {
+            // the recognition is the last step, so it may use all of the slack left before the deadline
+            _measure(state, [this, &frame]() {
+                Clock::time_point deadline = Clock::time_point::max();
+                if (_deadline > 0) {
+                    deadline = frame.timestamp + std::chrono::duration_cast<Clock::duration>(
+                            std::chrono::duration<double, std::milli>(_deadline));
+                }
+                _components.trackedRecognizer->recognize(frame.faces, *_components.tracks, deadline);
+            }, true);
+        }
+        if (frame.isDegraded && _components.trackedRecognizer != nullptr) {
+            ++state.skipped;
+        }
+
+        if (_deadline > 0) {
+            std::chrono::duration<double, std::milli> latency = Clock::now() - frame.timestamp;
+            if (latency.count() > _deadline) {
+                ++_deadlineMissesCount;
+            }
+        }
+
+        Item item;
+        item.frame = std::move(frame);
+        if (_queues.back()->push(std::move(item))) {
+            ++_deliveredCount;
+        }
+    }
+
+    Pipeline::Decision Pipeline::_schedule(std::size_t stage, Frame const &frame) const {
+        if (_deadline <= 0) {
+            return Decision::Process;
+        }
+
+        bool isOptional = _stages[stage]->isOptional || (stage + 1 == _stages.size()
+                                                         && _components.trackedRecognizer != nullptr);
+        if (frame.isDegraded && isOptional) {
+            return Decision::Skip;
+        }
+
+        // the time needed by the remaining stages with and without the optional ones
+        double required = 0, full = 0;
+        for (std::size_t i = stage; i < _stages.size(); ++i) {
+            double duration = _stages[i]->duration;
+            full += duration + _stages[i]->optionalDuration;
+            if (!_stages[i]->isOptional) {
+                required += duration;
+            }
+        }
+
+        std::chrono::duration<double, std::milli> age = Clock::now() - frame.timestamp;
+        if (age.count() + required > _deadline) {
+            return Decision::Drop;
+        }
+        if (isOptional && age.count() + full > _deadline) {
+            return Decision::Skip;
+        }
+        return Decision::Process;
+    }
+
+    std::vector<Pipeline::StageStats> Pipeline::getStageStats() const {
+        std::vector<StageStats> res;
+        for (auto const &stage : _stages) {
+            res.push_back({stage->name, stage->isOptional, stage->processed, stage->dropped, stage->skipped,
+                           stage->duration, stage->optionalDuration});
+        }
+        return res;
+    }
+
+}
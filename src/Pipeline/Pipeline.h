@@ -0,0 +1,332 @@
+/**
+ * @file Pipeline.h
+ * @author Люнгрин Андрей aka prostoichelovek <iam.prostoi.chelovek@gmail.ru>
+ * @date 19 Oct 2026
+ * @copyright MIT License
+ *
+ * @brief This file contains a multi-threaded pipeline, which runs the components on the frames of a stream
+ */
+
+#ifndef FACES_PIPELINE_H
+#define FACES_PIPELINE_H
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <map>
+#include <memory>
+#include <thread>
+
+#include <spdlog/spdlog.h>
+
+#include <Config/Config.h>
+#include <utils/BoundedQueue.hpp>
+#include <utils/ThreadPool.h>
+#include <Detector/Detector.hpp>
+#include <Landmarker/Landmarker.hpp>
+#include <Aligner/Aligner.hpp>
+#include <QualityEstimator/QualityEstimator.hpp>
+#include <Recognizer/Recognizer.hpp>
+#include <Recognizer/TrackedRecognizer.h>
+#include <Tracker/TrackManager.h>
+
+namespace faces {
+
+    /**
+     * A pipeline, which runs each of the stages (detection, landmarks, alignment, quality, recognition)
+     * on its own worker threads, so the stages process different frames at the same time
+     * and the throughput is limited by the slowest stage rather than by their sum. @n
+     * A stage has one worker per component instance given to it, since the components are not thread-safe;
+     * the stages without components are skipped. The stages are connected by bounded lock-free queues, so a slow
+     * stage makes the previous ones wait. The frames, which do not fit into the input queue,
+     * are handled according to the configured OverflowPolicy. @n
+     * The tracking (and the track-aware recognition) depends on the previous frames, so it runs on a single
+     * worker after the frames are put back in their order; the results are delivered in the order of submission.
+     * A dropped frame is replaced with a marker item, which the later stages pass on without processing,
+     * so the ordered stage learns about the drop from its own input and does not wait for the frame. @n
+     * In the latency SLO mode (a non-zero `deadline`), each stage estimates the time left to process a frame
+     * by the average durations of the remaining stages; the tracking and the track-aware recognition are timed
+     * separately, so only the tracking counts as required. A frame, which cannot be finished in time by the required
+     * stages, is dropped, so the workers move on to the newer frames; if it can be finished only without
+     * the optional ones (alignment, quality, recognition and the track-aware recognition), they are skipped,
+     * and the labels of its faces are taken from their tracks. @n
+     * The workers of a stage may be pinned to their own CPUs (`stageCpus`) on Linux, e.g. to keep the detection
+     * and the recognition on different NUMA nodes; the parallel regions of the components run on the ThreadPool
+     */
+    class Pipeline {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        /**
+         * A frame passed through the pipeline
+         */
+        struct Frame {
+            /// an index of the frame in its source
+            std::size_t index = 0;
+            /// a time when the frame was captured
+            Clock::time_point timestamp;
+            cv::Mat img;
+            /// faces found on the frame by the stages
+            std::vector<Face> faces;
+            /// whether the optional stages were skipped to meet the deadline
+            bool isDegraded = false;
+        };
+
+        /**
+         * Statistics of a stage
+         */
+        struct StageStats {
+            std::string name;
+            /// whether the stage may be skipped to meet the deadline
+            bool isOptional = false;
+            std::size_t processed = 0;
+            /// frames dropped since they could not meet the deadline
+            std::size_t dropped = 0;
+            /// frames, which skipped the stage to meet the deadline
+            std::size_t skipped = 0;
+            /// an average time of processing a frame in milliseconds
+            double duration = 0;
+            /// an average time of the optional part of the stage (the track-aware recognition) in milliseconds,
+            /// which is not included in the @ref duration
+            double optionalDuration = 0;
+        };
+
+        /**
+         * Components of the pipeline, which are not owned by it;
+         * a component should not be used elsewhere while the pipeline is running
+         */
+        struct Components {
+            std::vector<Detector *> detectors;
+            std::vector<Landmarker *> landmarkers;
+            std::vector<Aligner *> aligners;
+            std::vector<QualityEstimator *> qualityEstimators;
+            /// recognizers of all of the faces on the frame; not needed if there is a trackedRecognizer
+            std::vector<Recognizer *> recognizers;
+            TrackManager *tracks = nullptr;
+            /// a recognizer run after the tracking; requires the tracks
+            TrackedRecognizer *trackedRecognizer = nullptr;
+        };
+
+        /**
+         * Starts the workers of the stages
+         *
+         * @param components - the components to run
+         * @param config     - a config with the size of the queues and the overflow policy
+         */
+        Pipeline(Components components, Config const &config);
+
+        /**
+         * Stops the workers discarding the frames, which are not processed yet
+         */
+        ~Pipeline();
+
+        Pipeline(Pipeline const &) = delete;
+
+        Pipeline &operator=(Pipeline const &) = delete;
+
+        /**
+         * Puts the frame into the pipeline; it should be called from a single thread
+         *
+         * @return whether the frame was accepted, or it was dropped because the input queue is full
+         */
+        bool submit(Frame frame);
+
+        /**
+         * Takes the next processed frame waiting for it
+         *
+         * @param frame - a destination of the frame
+         *
+         * @return false if the pipeline is closed and all of the frames are taken
+         */
+        bool next(Frame &frame);
+
+        /**
+         * Takes the next processed frame if it is ready
+         *
+         * @return whether a frame was taken
+         */
+        bool tryNext(Frame &frame);
+
+        /**
+         * Tells the pipeline, that there will be no more frames;
+         * the submitted ones are still processed and may be taken with @ref next
+         */
+        void close();
+
+        [[nodiscard]] std::size_t getSubmittedCount() const {
+            return _submittedCount;
+        }
+
+        /**
+         * @return a number of the frames dropped according to the overflow policy
+         */
+        [[nodiscard]] std::size_t getDroppedCount() const {
+            return _droppedCount;
+        }
+
+        [[nodiscard]] std::size_t getDeliveredCount() const {
+            return _deliveredCount;
+        }
+
+        /**
+         * @return a number of the delivered frames, which did not meet the deadline
+         */
+        [[nodiscard]] std::size_t getDeadlineMissesCount() const {
+            return _deadlineMissesCount;
+        }
+
+        /**
+         * @return statistics of each of the stages, including the tracking one
+         */
+        [[nodiscard]] std::vector<StageStats> getStageStats() const;
+
+        [[nodiscard]] bool isOk() const {
+            return _ok;
+        }
+
+    protected:
+        /**
+         * A frame with its number of submission, by which the order is restored
+         */
+        struct Item {
+            std::size_t sequence = 0;
+            Frame frame;
+            /// whether it is a marker of a dropped frame without the frame itself
+            bool isDropped = false;
+        };
+
+        using Queue = BoundedQueue<Item>;
+
+        /// a function, which runs a single component on the frame
+        using Processor = std::function<void(Frame &)>;
+
+        /**
+         * A state of a stage shared by its workers
+         */
+        struct Stage {
+            std::string name;
+            bool isOptional = false;
+            /// a number of the running workers; the last one closes the next queue
+            std::atomic<std::size_t> runningWorkers = 0;
+            /// an exponential moving average of the processing time in milliseconds
+            std::atomic<double> duration = 0;
+            /// an exponential moving average of the time of the optional part of the stage in milliseconds
+            std::atomic<double> optionalDuration = 0;
+            std::atomic<std::size_t> processed = 0;
+            std::atomic<std::size_t> dropped = 0;
+            std::atomic<std::size_t> skipped = 0;
+        };
+
+        /**
+         * What to do with a frame at a stage to meet the deadline
+         */
+        enum class Decision {
+            Process,
+            Skip,
+            Drop
+        };
+
+        bool _ok = false;
+
+        Components _components;
+
+        std::size_t _queueSize = 4;
+        OverflowPolicy _overflowPolicy = OverflowPolicy::Block;
+
+        /// a maximal time from the capture to the result in milliseconds OR 0 to process all of the frames
+        double _deadline = 0;
+
+        /// CPUs to pin the workers of a stage to by its name
+        std::map<std::string, std::vector<int>> _stageCpus;
+
+        /// input queues of the parallel stages, followed by the input of the ordered stage and the output
+        std::vector<std::unique_ptr<Queue>> _queues;
+
+        /// the parallel stages followed by the ordered one
+        std::vector<std::unique_ptr<Stage>> _stages;
+
+        std::vector<std::thread> _workers;
+
+        std::size_t _nextSequence = 0;
+
+        std::atomic<std::size_t> _submittedCount = 0;
+        std::atomic<std::size_t> _droppedCount = 0;
+        std::atomic<std::size_t> _deliveredCount = 0;
+        std::atomic<std::size_t> _deadlineMissesCount = 0;
+
+        /**
+         * Parses the CPUs of the stages in the format "detection:0-3;recognition:4-7"
+         */
+        void _parseStageCpus(std::string const &stageCpus);
+
+        /**
+         * Pins the calling worker to the CPUs of the stage if they are given
+         */
+        void _pin(std::string const &stage) const;
+
+        /**
+         * Runs a worker of a parallel stage
+         *
+         * @param stage     - an index of the stage, which is also an index of its input queue
+         * @param processor - a function to run on each of the frames
+         */
+        void _runStage(std::size_t stage, Processor const &processor);
+
+        /**
+         * Runs the worker, which restores the order of the frames, tracks them and delivers the results
+         */
+        void _runOrdered();
+
+        /**
+         * Tracks the frame and puts it into the output queue
+         */
+        void _deliver(Frame &frame);
+
+        /**
+         * Decides whether the frame may be processed by the stage in time
+         *
+         * @param stage - an index of the stage
+         * @param frame - the frame
+         */
+        [[nodiscard]] Decision _schedule(std::size_t stage, Frame const &frame) const;
+
+        /**
+         * Runs the function and adds its duration to the average of the stage
+         *
+         * @param isOptional - whether the function is the optional part of the stage, which is averaged separately
+         *                     and does not count as a processed frame
+         */
+        template<typename Function>
+        void _measure(Stage &stage, Function function, bool isOptional = false) {
+            auto start = Clock::now();
+            function();
+            std::chrono::duration<double, std::milli> elapsed = Clock::now() - start;
+
+            // a race between the workers only loses a sample
+            std::atomic<double> &average = isOptional ? stage.optionalDuration : stage.duration;
+            double duration = average;
+            average = duration == 0 ? elapsed.count() : duration * 0.9 + elapsed.count() * 0.1;
+            if (!isOptional) {
+                ++stage.processed;
+            }
+        }
+
+    };
+
+    FACES_AUGMENT_CONFIG(Pipeline,
+                         FACES_ADD_CONFIG_OPTION("Pipeline.queueSize", "pipelineQueueSize", 4, false,
+                                                 "A capacity of the queues between the stages of the pipeline")
+                                 FACES_ADD_CONFIG_OPTION("Pipeline.overflowPolicy", "overflowPolicy", "block",
+                                                         false, "What to do with a new frame when the pipeline "
+                                                                "is full: block, dropOldest or dropNewest")
+                                 FACES_ADD_CONFIG_OPTION("Pipeline.deadline", "deadline", 0, false,
+                                                         "A maximal time from the capture of a frame to its result "
+                                                         "in milliseconds; 0 to process all of the frames")
+                                 FACES_ADD_CONFIG_OPTION("Pipeline.stageCpus", "stageCpus", "", false,
+                                                         "CPUs to pin the workers of the stages to, "
+                                                         "e.g. detection:0-3;recognition:4-7")
+    )
+
+}
+
+#endif //FACES_PIPELINE_H
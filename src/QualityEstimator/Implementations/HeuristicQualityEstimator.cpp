@@ -0,0 +1,93 @@
+/**
+ * @file HeuristicQualityEstimator.cpp
+ * @author Люнгрин Андрей aka prostoichelovek <iam.prostoi.chelovek@gmail.com>
+ * @date 19 Oct 2026
+ * @copyright MIT License
+ */
+
+#include "HeuristicQualityEstimator.h"
+
+namespace faces {
+
+    HeuristicQualityEstimator::HeuristicQualityEstimator(Config const &config) {
+        _ok = true;
+
+        try {
+            _minSharpness = config["HeuristicQualityEstimator.minSharpness"].getNumber();
+            _minSize = config["HeuristicQualityEstimator.minSize"].getNumber();
+            _minExposure = config["HeuristicQualityEstimator.minExposure"].getNumber();
+            _maxExposure = config["HeuristicQualityEstimator.maxExposure"].getNumber();
+            _maxYaw = config["HeuristicQualityEstimator.maxYaw"].getNumber();
+        } catch (std::out_of_range &e) {
+            spdlog::error("Cannot get thresholds of the HeuristicQualityEstimator from the config, "
+                          "using the default ones");
+        }
+    }
+
+    FaceQuality HeuristicQualityEstimator::_estimate(Face const &face) {
+        FaceQuality quality;
+
+        cv::Mat gray;
+        if (face.img.channels() == 1) {
+            gray = face.img;
+        } else {
+            cv::cvtColor(face.img, gray, cv::COLOR_BGR2GRAY);
+        }
+
+        cv::Scalar mean, stdDev;
+        cv::meanStdDev(gray, mean, stdDev);
+        quality.exposure = mean[0] / 255.0;
+
+        cv::Mat laplacian;
+        cv::Laplacian(gray, laplacian, CV_16S);
+        cv::meanStdDev(laplacian, mean, stdDev);
+        quality.sharpness = stdDev[0] * stdDev[0];
+
+        quality.size = std::min(face.rect.width, face.rect.height);
+        quality.yaw = _estimateYaw(face.landmarks);
+
+        quality.acceptable = quality.sharpness >= _minSharpness
+                             && quality.size >= _minSize
+                             && quality.exposure >= _minExposure && quality.exposure <= _maxExposure
+                             && std::abs(quality.yaw) <= _maxYaw;
+
+        // each factor is 1 for a perfect face and 0.5 at its threshold
+        double sharpnessFactor = quality.sharpness / (quality.sharpness + _minSharpness);
+        double sizeFactor = quality.size / (quality.size + _minSize);
+        double exposureMiddle = (_minExposure + _maxExposure) / 2;
+        double exposureFactor = 1 - std::min(1.0, std::abs(quality.exposure - exposureMiddle)
+                                                  / (_maxExposure - exposureMiddle) / 2);
+        double yawFactor = 1 - std::min(1.0, std::abs(quality.yaw) / _maxYaw / 2);
+        quality.score = sharpnessFactor * sizeFactor * exposureFactor * yawFactor;
+
+        return quality;
+    }
+
+    double HeuristicQualityEstimator::_estimateYaw(std::vector<cv::Point> const &landmarks) {
+        cv::Point2d firstEye, secondEye, nose;
+        if (landmarks.size() == 5) {
+            // dlib`s 5-point layout: corners of the first eye, corners of the second eye, nose
+            firstEye = cv::Point2d(landmarks[0] + landmarks[1]) / 2;
+            secondEye = cv::Point2d(landmarks[2] + landmarks[3]) / 2;
+            nose = landmarks[4];
+        } else if (landmarks.size() == 68) {
+            firstEye = cv::Point2d(landmarks[36] + landmarks[39]) / 2;
+            secondEye = cv::Point2d(landmarks[42] + landmarks[45]) / 2;
+            nose = landmarks[30];
+        } else {
+            return 0;
+        }
+
+        // the nose tip moves from the middle of the eyes to one of them as the head turns by 90 degrees
+        cv::Point2d eyeAxis = secondEye - firstEye;
+        double halfEyeDistanceSq = eyeAxis.dot(eyeAxis) / 2;
+        if (halfEyeDistanceSq == 0) {
+            return 0;
+        }
+        cv::Point2d eyesMiddle = (firstEye + secondEye) / 2;
+        double offset = (nose - eyesMiddle).dot(eyeAxis) / halfEyeDistanceSq;
+
+        return std::asin(std::clamp(offset, -1.0, 1.0)) * 180 / CV_PI;
+    }
+
+}
@@ -0,0 +1,66 @@
+/**
+ * @file HeuristicQualityEstimator.h
+ * @author Люнгрин Андрей aka prostoichelovek <iam.prostoi.chelovek@gmail.com>
+ * @date 19 Oct 2026
+ * @copyright MIT License
+ *
+ * @brief This file contains a face quality estimator based on cheap image heuristics
+ */
+
+#ifndef FACES_HEURISTICQUALITYESTIMATOR_H
+#define FACES_HEURISTICQUALITYESTIMATOR_H
+
+#include <spdlog/spdlog.h>
+
+#include <utils/utils.h>
+#include <Config/Config.h>
+
+#include <QualityEstimator/QualityEstimator.hpp>
+
+namespace faces {
+
+    /**
+     * A face quality estimator, which measures blur (a variance of the Laplacian), size of the face,
+     * exposure and an approximate head yaw from 5 or 68 landmarks. @n
+     * A face is acceptable if all of the measures are within the thresholds from the config
+     */
+    class HeuristicQualityEstimator : public QualityEstimator {
+    public:
+        FACES_MAIN_CONSTRUCTOR(explicit HeuristicQualityEstimator, Config const &config);
+
+    protected:
+        double _minSharpness = 50;
+        double _minSize = 40;
+        double _minExposure = 0.15;
+        double _maxExposure = 0.9;
+        double _maxYaw = 35;
+
+        FaceQuality _estimate(Face const &face) override;
+
+        /**
+         * Estimates a head yaw from the landmarks
+         *
+         * @return a yaw in degrees OR 0 if the landmarks layout is unknown
+         */
+        [[nodiscard]] static double _estimateYaw(std::vector<cv::Point> const &landmarks);
+
+    };
+
+    FACES_REGISTER_SUBCLASS(QualityEstimator, HeuristicQualityEstimator, Heuristic)
+
+    FACES_AUGMENT_CONFIG(HeuristicQualityEstimator,
+                         FACES_ADD_CONFIG_OPTION("HeuristicQualityEstimator.minSharpness", "minSharpness", 50,
+                                                 false, "A minimal variance of the Laplacian of a face image")
+                                 FACES_ADD_CONFIG_OPTION("HeuristicQualityEstimator.minSize", "minFaceSize", 40,
+                                                         false, "A minimal size of a face in pixels")
+                                 FACES_ADD_CONFIG_OPTION("HeuristicQualityEstimator.minExposure", "minExposure",
+                                                         0.15, false, "A minimal mean brightness of a face")
+                                 FACES_ADD_CONFIG_OPTION("HeuristicQualityEstimator.maxExposure", "maxExposure",
+                                                         0.9, false, "A maximal mean brightness of a face")
+                                 FACES_ADD_CONFIG_OPTION("HeuristicQualityEstimator.maxYaw", "maxYaw", 35,
+                                                         false, "A maximal head yaw in degrees")
+    )
+
+}
+
+#endif //FACES_HEURISTICQUALITYESTIMATOR_H
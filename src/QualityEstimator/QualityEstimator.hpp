@@ -0,0 +1,88 @@
+/**
+ * @file QualityEstimator.hpp
+ * @author Люнгрин Андрей aka prostoichelovek <iam.prostoi.chelovek@gmail.com>
+ * @date 19 Oct 2026
+ * @copyright MIT License
+ *
+ * @brief This file contains a base class for face quality estimators
+ */
+
+#ifndef FACES_QUALITYESTIMATOR_HPP
+#define FACES_QUALITYESTIMATOR_HPP
+
+#include <Face/Face.h>
+#include <utils/Async.hpp>
+
+namespace faces {
+
+    /**
+     * A base class for all of the face quality estimators. @n
+     * They should be run after the Aligner, and the Recognizer skips faces which are not acceptable
+     */
+    class QualityEstimator {
+    public:
+        /**
+         * Estimates quality of the given face and stores it in the face. @n
+         * This is a wrapper around the actual @ref _estimate method
+         *
+         * @param face - a face, estimate quality of which
+         */
+        void estimate(Face &face) {
+            if (!_ok) return;
+
+            if (face.img.empty()) return;
+            face.quality = _estimate(face);
+        }
+
+        /**
+         * Estimates quality of a bunch of faces
+         *
+         * @overload estimate(Face &)
+         */
+        void estimate(std::vector<Face> &faces) {
+            for (Face &face : faces) {
+                estimate(face);
+            }
+        }
+
+        /**
+         * Estimates quality of the given faces on the ThreadPool;
+         * the asynchronous calls of an estimator run one at a time in the order of the calls
+         *
+         * @return a future of the faces with their quality
+         */
+        Future<std::vector<Face>> estimateAsync(std::vector<Face> faces) {
+            return _strand.run([this, faces]() mutable {
+                estimate(faces);
+                return std::move(faces);
+            });
+        }
+
+        /**
+         * @return a value of the @ref _ok flag
+         */
+        [[nodiscard]] bool isOk() const {
+            return _ok;
+        }
+
+    protected:
+        /// the flag which indicates the readiness of the estimator
+        bool _ok = false;
+
+        /// runs the asynchronous calls one at a time
+        Strand _strand;
+
+        /**
+         * Estimates quality of the given face
+         *
+         * @param face - a face with an aligned image
+         *
+         * @return quality of the face
+         */
+        virtual FaceQuality _estimate(Face const &face) = 0;
+
+    };
+
+}
+
+#endif //FACES_QUALITYESTIMATOR_HPP
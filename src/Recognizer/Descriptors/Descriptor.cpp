@@ -19,6 +19,40 @@ namespace faces {
         return _computeDescriptors(preparedImg);
     }
 
+    std::vector<std::vector<double>> Descriptor::computeDescriptors(std::vector<cv::Mat> const &faceImgs) {
+        if (!_ok) {
+            return {};
+        }
+
+        std::vector<cv::Mat> preparedImgs;
+        std::transform(faceImgs.begin(), faceImgs.end(), std::back_inserter(preparedImgs),
+                       [this](cv::Mat const &faceImg) { return prepareImage(faceImg); });
+
+        return _computeDescriptorsBatch(preparedImgs);
+    }
+
+    double Descriptor::distance(std::vector<double> const &a, std::vector<double> const &b) {
+        if (a.size() != b.size() || a.empty()) {
+            return std::numeric_limits<double>::infinity();
+        }
+
+        if (get_metric() == Metric::Cosine) {
+            double dot = 0, normA = 0, normB = 0;
+            for (std::size_t i = 0; i < a.size(); ++i) {
+                dot += a[i] * b[i];
+                normA += a[i] * a[i];
+                normB += b[i] * b[i];
+            }
+            return normA > 0 && normB > 0 ? 1 - dot / std::sqrt(normA * normB) : 1;
+        }
+
+        double distance = 0;
+        for (std::size_t i = 0; i < a.size(); ++i) {
+            distance += (a[i] - b[i]) * (a[i] - b[i]);
+        }
+        return std::sqrt(distance);
+    }
+
     cv::Mat Descriptor::prepareImage(cv::Mat const &faceImg) {
         cv::Mat prepared;
         cv::resize(faceImg, prepared, get_faceSize());
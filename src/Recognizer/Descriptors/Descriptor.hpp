@@ -10,6 +10,8 @@
 #ifndef FACES_DESCRIPTOR_HPP
 #define FACES_DESCRIPTOR_HPP
 
+#include <limits>
+
 #include <opencv2/opencv.hpp>
 
 #include "utils/utils.h"
@@ -21,6 +23,17 @@ namespace faces {
      */
     class Descriptor {
     public:
+        /**
+         * A metric, in which the descriptors are compared
+         */
+        enum class Metric {
+            Euclidean,
+            /// one minus the cosine similarity
+            Cosine
+        };
+
+        virtual ~Descriptor() = default;
+
         /**
          * Estimates descriptors for the given face image
          * It is just a wrapper around @ref _computeDescriptors, which check `_ok` and prepares an image
@@ -31,6 +44,16 @@ namespace faces {
          */
         std::vector<double> computeDescriptors(cv::Mat const &faceImg);
 
+        /**
+         * Estimates descriptors for a batch of face images
+         * It is just a wrapper around @ref _computeDescriptorsBatch, which check `_ok` and prepares images
+         *
+         * @param faceImgs - face ROIs
+         *
+         * @return a descriptor vector for each of the given faces OR an empty vector if not `_ok`
+         */
+        std::vector<std::vector<double>> computeDescriptors(std::vector<cv::Mat> const &faceImgs);
+
         /**
          * Prepares an image for descriptor by resizing it and applying a custom @ref _prepareImage method
          *
@@ -40,6 +63,37 @@ namespace faces {
          */
         cv::Mat prepareImage(cv::Mat const &faceImg);
 
+        /**
+         * Creates a replica of this descriptor, which may be used concurrently with it;
+         * implementations should copy the already loaded model instead of loading it again
+         *
+         * @return a new descriptor, owned by the caller, OR nullptr if this descriptor cannot be replicated
+         */
+        [[nodiscard]] virtual Descriptor *clone() const {
+            return nullptr;
+        }
+
+        /**
+         * Computes a distance between the given descriptors in the metric of this descriptor
+         *
+         * @return the distance OR infinity if the sizes of the descriptors differ
+         */
+        [[nodiscard]] double distance(std::vector<double> const &a, std::vector<double> const &b);
+
+        /**
+         * @return a maximal distance between the descriptors of the same person
+         */
+        [[nodiscard]] double getMatchDistance() {
+            return get_matchDistance();
+        }
+
+        /**
+         * @return a number of values in the descriptors OR 0 if it is unknown yet (e.g. not `_ok`)
+         */
+        [[nodiscard]] int getDimension() const {
+            return _dimension;
+        }
+
         /**
          * @return a value of the @ref _ok flag
          */
@@ -51,9 +105,18 @@ namespace faces {
         /// the flag which indicates the readiness of the detector
         bool _ok = false;
 
+        /// a number of values in the descriptors, should be set by implementations when the model is loaded
+        int _dimension = 0;
+
         /// a size of the face image to pass to the detector
         FACES_DECLARE_ATTRIBUTE(cv::Size, faceSize)
 
+        /// a metric, in which the descriptors of the network are compared
+        FACES_DECLARE_ATTRIBUTE(Metric, metric)
+
+        /// a maximal distance in the @ref metric between the descriptors of the same person
+        FACES_DECLARE_ATTRIBUTE(double, matchDistance)
+
         /**
          * Estimates descriptors for the given face image
          *
@@ -63,6 +126,22 @@ namespace faces {
          */
         virtual std::vector<double> _computeDescriptors(cv::Mat const &faceImg) = 0;
 
+        /**
+         * Estimates descriptors for a batch of face images;
+         * the default implementation processes them one by one, you may override it to run a real batch
+         *
+         * @param faceImgs - prepared face ROIs
+         *
+         * @return a descriptor vector for each of the given faces
+         */
+        virtual std::vector<std::vector<double>> _computeDescriptorsBatch(std::vector<cv::Mat> const &faceImgs) {
+            std::vector<std::vector<double>> res;
+            for (cv::Mat const &faceImg : faceImgs) {
+                res.emplace_back(_computeDescriptors(faceImg));
+            }
+            return res;
+        }
+
         /**
          * A custom image preprocessing method, you may override;
          * It is called after the resizing and before descriptors computing
@@ -0,0 +1,104 @@
+/**
+ * @file DescriptorCache.cpp
+ * @author Люнгрин Андрей aka prostoichelovek <iam.prostoi.chelovek@gmail.ru>
+ * @date 19 Oct 2026
+ * @copyright MIT License
+ */
+
+#include "DescriptorCache.h"
+
+namespace faces {
+
+    DescriptorCache::DescriptorCache(std::size_t capacity, int tolerance, double maxDifference)
+            : _capacity(capacity), _tolerance(tolerance), _maxDifference(maxDifference) {
+        _entries.reserve(capacity);
+    }
+
+    void DescriptorCache::configure(std::size_t capacity, int tolerance, double maxDifference) {
+        std::lock_guard lock(_mutex);
+        _capacity = capacity;
+        _tolerance = tolerance;
+        _maxDifference = maxDifference;
+        _entries.clear();
+        _entries.reserve(capacity);
+    }
+
+    DescriptorCache::Key DescriptorCache::makeKey(cv::Mat const &img) {
+        cv::Mat gray, hashThumbnail;
+        if (img.channels() == 1) {
+            gray = img;
+        } else {
+            cv::cvtColor(img, gray, cv::COLOR_BGR2GRAY);
+        }
+
+        Key key;
+        cv::resize(gray, key.thumbnail, {16, 16}, 0, 0, cv::INTER_AREA);
+        cv::resize(key.thumbnail, hashThumbnail, {9, 8}, 0, 0, cv::INTER_AREA);
+
+        for (int y = 0; y < 8; ++y) {
+            auto const *row = hashThumbnail.ptr<std::uint8_t>(y);
+            for (int x = 0; x < 8; ++x) {
+                key.hash = (key.hash << 1) | (row[x] < row[x + 1]);
+            }
+        }
+        return key;
+    }
+
+    std::optional<DescriptorCache::Entry> DescriptorCache::find(Key const &key) {
+        std::lock_guard lock(_mutex);
+
+        Entry *best = nullptr;
+        int bestDistance = _tolerance + 1;
+        bool isCollision = false;
+        for (Entry &entry : _entries) {
+            int distance = __builtin_popcountll(entry.key.hash ^ key.hash);
+            if (distance >= bestDistance) {
+                continue;
+            }
+
+            // the hash compares only the neighbour pixels, so the images themselves should be alike as well
+            if (cv::norm(entry.key.thumbnail, key.thumbnail, cv::NORM_L1) / entry.key.thumbnail.total()
+                > _maxDifference) {
+                isCollision = true;
+                continue;
+            }
+            bestDistance = distance;
+            best = &entry;
+        }
+
+        if (best == nullptr) {
+            ++_misses;
+            if (isCollision) {
+                ++_collisions;
+            }
+            return std::nullopt;
+        }
+
+        ++_hits;
+        best->lastUse = ++_useCounter;
+        return *best;
+    }
+
+    void DescriptorCache::insert(Key key, std::vector<double> descriptor, int label) {
+        if (!isEnabled()) {
+            return;
+        }
+
+        std::lock_guard lock(_mutex);
+        Entry entry{std::move(key), std::move(descriptor), label, ++_useCounter};
+        if (_entries.size() < _capacity) {
+            _entries.emplace_back(std::move(entry));
+            return;
+        }
+
+        auto leastRecent = std::min_element(_entries.begin(), _entries.end(),
+                                            [](Entry const &a, Entry const &b) { return a.lastUse < b.lastUse; });
+        *leastRecent = std::move(entry);
+    }
+
+    void DescriptorCache::clear() {
+        std::lock_guard lock(_mutex);
+        _entries.clear();
+    }
+
+}
@@ -0,0 +1,125 @@
+/**
+ * @file DescriptorCache.h
+ * @author Люнгрин Андрей aka prostoichelovek <iam.prostoi.chelovek@gmail.ru>
+ * @date 19 Oct 2026
+ * @copyright MIT License
+ *
+ * @brief This file contains an LRU cache of face descriptors keyed by a perceptual hash of the face image
+ */
+
+#ifndef FACES_DESCRIPTORCACHE_H
+#define FACES_DESCRIPTORCACHE_H
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+#include <opencv2/opencv.hpp>
+
+namespace faces {
+
+    /**
+     * An LRU cache of face descriptors and labels keyed by a perceptual hash of the face image,
+     * so near-identical images are recognized without computing their descriptors. @n
+     * Different faces may have close hashes, so a hit is confirmed by comparing grayscale thumbnails
+     * of the images, which costs much less than the descriptor. @n
+     * The cache is safe to use from several threads (e.g. the workers of a Pipeline stage)
+     */
+    class DescriptorCache {
+    public:
+        /**
+         * A key of a face image
+         */
+        struct Key {
+            /// a difference hash of the image
+            std::uint64_t hash = 0;
+            /// a grayscale thumbnail of the image to confirm the hash matches
+            cv::Mat thumbnail;
+        };
+
+        /**
+         * A cached result of the recognition
+         */
+        struct Entry {
+            Key key;
+            std::vector<double> descriptor;
+            int label = -1;
+            /// a value of the use counter at the last access
+            std::uint64_t lastUse = 0;
+        };
+
+        /**
+         * @param capacity      - a maximal number of entries, 0 disables the cache
+         * @param tolerance     - a maximal Hamming distance between hashes of matching images
+         * @param maxDifference - a maximal mean absolute difference between the thumbnails of matching images
+         */
+        explicit DescriptorCache(std::size_t capacity = 0, int tolerance = 0, double maxDifference = 8);
+
+        /**
+         * Changes the parameters of the cache, removing all of the entries
+         */
+        void configure(std::size_t capacity, int tolerance, double maxDifference);
+
+        /**
+         * Computes a difference hash of the given image
+         * by comparing neighbour pixels of its grayscale 9x8 thumbnail, and its 16x16 grayscale thumbnail
+         */
+        [[nodiscard]] static Key makeKey(cv::Mat const &img);
+
+        /**
+         * Finds an entry with the closest hash within the tolerance, whose thumbnail matches the given one,
+         * marking it as recently used
+         *
+         * @return a copy of the found entry OR nothing on miss
+         */
+        std::optional<Entry> find(Key const &key);
+
+        /**
+         * Inserts a new entry, evicting the least recently used one if the cache is full
+         */
+        void insert(Key key, std::vector<double> descriptor, int label);
+
+        /**
+         * Removes all of the entries, e.g. after the classifier was retrained
+         */
+        void clear();
+
+        [[nodiscard]] bool isEnabled() const {
+            return _capacity != 0;
+        }
+
+        [[nodiscard]] std::size_t getHits() const {
+            return _hits;
+        }
+
+        [[nodiscard]] std::size_t getMisses() const {
+            return _misses;
+        }
+
+        /**
+         * @return a number of the hash matches, which were rejected by their thumbnails
+         */
+        [[nodiscard]] std::size_t getCollisions() const {
+            return _collisions;
+        }
+
+    private:
+        std::atomic<std::size_t> _capacity;
+        int _tolerance;
+        double _maxDifference;
+
+        std::vector<Entry> _entries;
+        std::uint64_t _useCounter = 0;
+        std::mutex _mutex;
+
+        std::atomic<std::size_t> _hits = 0;
+        std::atomic<std::size_t> _misses = 0;
+        std::atomic<std::size_t> _collisions = 0;
+
+    };
+
+}
+
+#endif //FACES_DESCRIPTORCACHE_H
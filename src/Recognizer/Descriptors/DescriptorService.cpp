@@ -0,0 +1,145 @@
+/**
+ * @file DescriptorService.cpp
+ * @author Люнгрин Андрей aka prostoichelovek <iam.prostoi.chelovek@gmail.ru>
+ * @date 19 Oct 2026
+ * @copyright MIT License
+ */
+
+#include "DescriptorService.h"
+
+namespace faces {
+
+    DescriptorService::DescriptorService(Descriptor *descriptor, Config const &config)
+            : _descriptor(descriptor) {
+        try {
+            _batchSize = std::max(1, config["DescriptorService.batchSize"].getInt());
+            _maxDelay = std::chrono::duration_cast<Clock::duration>(
+                    std::chrono::duration<double, std::milli>(config["DescriptorService.maxDelay"].getNumber()));
+        } catch (std::out_of_range &e) {
+            spdlog::error("Cannot get batching parameters of the DescriptorService from the config, "
+                          "using the default ones");
+        }
+
+        _batchFillHistogram.assign(_batchSize + 1, 0);
+        _queueDelayHistogram.assign(64, 0);
+
+        _worker = std::thread(&DescriptorService::_run, this);
+    }
+
+    DescriptorService::~DescriptorService() {
+        {
+            std::lock_guard lock(_mutex);
+            _stopping = true;
+        }
+        _queueChanged.notify_all();
+        _worker.join();
+    }
+
+    std::future<std::vector<double>> DescriptorService::submit(cv::Mat faceImg) {
+        Request request;
+        request.img = std::move(faceImg);
+        std::future<std::vector<double>> res = request.promise.get_future();
+
+        _enqueue(std::move(request));
+        return res;
+    }
+
+    void DescriptorService::submit(cv::Mat faceImg, Callback callback) {
+        Request request;
+        request.img = std::move(faceImg);
+        request.callback = std::move(callback);
+
+        _enqueue(std::move(request));
+    }
+
+    std::vector<std::size_t> DescriptorService::getBatchFillHistogram() const {
+        std::lock_guard lock(_mutex);
+        return _batchFillHistogram;
+    }
+
+    std::vector<std::size_t> DescriptorService::getQueueDelayHistogram() const {
+        std::lock_guard lock(_mutex);
+        return _queueDelayHistogram;
+    }
+
+    void DescriptorService::_enqueue(Request request) {
+        request.enqueued = Clock::now();
+        {
+            std::lock_guard lock(_mutex);
+            _queue.emplace_back(std::move(request));
+        }
+        _queueChanged.notify_one();
+    }
+
+    void DescriptorService::_run() {
+        std::vector<Request> batch;
+
+        std::unique_lock lock(_mutex);
+        while (true) {
+            _queueChanged.wait(lock, [this] { return _stopping || !_queue.empty(); });
+            if (_queue.empty()) {
+                // stopping and there is nothing left
+                return;
+            }
+
+            Clock::time_point deadline = _queue.front().enqueued + _maxDelay;
+            _queueChanged.wait_until(lock, deadline, [this] {
+                return _stopping || _queue.size() >= _batchSize;
+            });
+
+            Clock::time_point now = Clock::now();
+            std::size_t size = std::min(_batchSize, _queue.size());
+            for (std::size_t i = 0; i < size; ++i) {
+                Request &request = _queue.front();
+
+                auto delay = std::chrono::duration_cast<std::chrono::microseconds>(now - request.enqueued).count();
+                std::size_t bucket = 0;
+                while (delay > 0 && bucket + 1 < _queueDelayHistogram.size()) {
+                    delay >>= 1;
+                    ++bucket;
+                }
+                ++_queueDelayHistogram[bucket];
+
+                batch.emplace_back(std::move(request));
+                _queue.pop_front();
+            }
+            ++_batchFillHistogram[size];
+
+            lock.unlock();
+            _process(batch);
+            batch.clear();
+            lock.lock();
+        }
+    }
+
+    void DescriptorService::_process(std::vector<Request> &batch) {
+        std::vector<cv::Mat> imgs;
+        for (Request const &request : batch) {
+            imgs.emplace_back(request.img);
+        }
+
+        std::vector<std::vector<double>> descriptors;
+        std::exception_ptr error;
+        try {
+            descriptors = _descriptor->computeDescriptors(imgs);
+        } catch (...) {
+            error = std::current_exception();
+        }
+        // the descriptor is not `ok`
+        if (!error && descriptors.size() != batch.size()) {
+            descriptors.assign(batch.size(), {});
+        }
+
+        for (std::size_t i = 0; i < batch.size(); ++i) {
+            Request &request = batch[i];
+            if (request.callback) {
+                request.callback(error ? std::vector<double>() : std::move(descriptors[i]));
+            } else if (error) {
+                request.promise.set_exception(error);
+            } else {
+                request.promise.set_value(std::move(descriptors[i]));
+            }
+        }
+    }
+
+}
@@ -0,0 +1,143 @@
+/**
+ * @file DescriptorService.h
+ * @author Люнгрин Андрей aka prostoichelovek <iam.prostoi.chelovek@gmail.ru>
+ * @date 19 Oct 2026
+ * @copyright MIT License
+ *
+ * @brief This file contains a service, which batches descriptor computations across frames and streams
+ */
+
+#ifndef FACES_DESCRIPTORSERVICE_H
+#define FACES_DESCRIPTORSERVICE_H
+
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <future>
+#include <functional>
+#include <condition_variable>
+
+#include <spdlog/spdlog.h>
+
+#include <Config/Config.h>
+
+#include "Descriptor.hpp"
+
+namespace faces {
+
+    /**
+     * A service, which collects face images submitted from any number of threads (frames, streams)
+     * and computes their descriptors in batches on its own thread. @n
+     * A batch is dispatched when it reaches `batchSize` images
+     * or when the oldest image in the queue has waited for `maxDelay`
+     *
+     * @note the descriptor must not be used by anyone else while the service is running
+     */
+    class DescriptorService {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        /// a function, which receives computed descriptors
+        using Callback = std::function<void(std::vector<double>)>;
+
+        /**
+         * Starts the service thread
+         *
+         * @param descriptor - a descriptor to use; it is not owned by this class
+         * @param config     - a config with the batching parameters
+         */
+        DescriptorService(Descriptor *descriptor, Config const &config);
+
+        DescriptorService(DescriptorService const &) = delete;
+
+        DescriptorService &operator=(DescriptorService const &) = delete;
+
+        /**
+         * Computes the remaining queued images and stops the service thread
+         */
+        ~DescriptorService();
+
+        /**
+         * Queues a face image
+         *
+         * @param faceImg - a face ROI
+         *
+         * @return a future of the descriptor of the face
+         */
+        std::future<std::vector<double>> submit(cv::Mat faceImg);
+
+        /**
+         * Queues a face image
+         *
+         * @param faceImg  - a face ROI
+         * @param callback - a function called on the service thread with the descriptor of the face
+         */
+        void submit(cv::Mat faceImg, Callback callback);
+
+        /**
+         * @return a histogram of the dispatched batch sizes, where i-th element is a number of batches of size i
+         */
+        [[nodiscard]] std::vector<std::size_t> getBatchFillHistogram() const;
+
+        /**
+         * @return a histogram of the time images spent in the queue,
+         *         where i-th element is a number of images, which waited for [2^(i-1), 2^i) microseconds
+         *         (the 0-th one is for less than a microsecond)
+         */
+        [[nodiscard]] std::vector<std::size_t> getQueueDelayHistogram() const;
+
+    private:
+        /**
+         * A queued face image
+         */
+        struct Request {
+            cv::Mat img;
+            std::promise<std::vector<double>> promise;
+            /// is used instead of the @ref promise if set
+            Callback callback;
+            Clock::time_point enqueued;
+        };
+
+        Descriptor *_descriptor;
+
+        std::size_t _batchSize = 16;
+        Clock::duration _maxDelay = std::chrono::milliseconds(10);
+
+        std::deque<Request> _queue;
+        mutable std::mutex _mutex;
+        std::condition_variable _queueChanged;
+        bool _stopping = false;
+
+        std::vector<std::size_t> _batchFillHistogram;
+        std::vector<std::size_t> _queueDelayHistogram;
+
+        std::thread _worker;
+
+        /**
+         * Adds a request to the queue
+         */
+        void _enqueue(Request request);
+
+        /**
+         * The service thread loop, which forms and computes batches
+         */
+        void _run();
+
+        /**
+         * Computes descriptors of the given requests and delivers the results
+         */
+        void _process(std::vector<Request> &batch);
+
+    };
+
+    FACES_AUGMENT_CONFIG(DescriptorService,
+                         FACES_ADD_CONFIG_OPTION("DescriptorService.batchSize", "descriptorBatchSize", 16, false,
+                                                 "A number of face images in a batch of the descriptor service")
+                                 FACES_ADD_CONFIG_OPTION("DescriptorService.maxDelay", "descriptorMaxDelay", 10,
+                                                         false, "A maximal time in milliseconds a face image waits "
+                                                                "for its batch to fill in the descriptor service")
+    )
+
+}
+
+#endif //FACES_DESCRIPTORSERVICE_H
@@ -42,6 +42,24 @@ namespace faces {
             return _classifyDescriptors(descriptors);
         }
 
+        /**
+         * Verifies that the given face descriptor belongs to the given label. @n
+         * It is a fast path for faces with a tentative identity, so its cost should not depend on the number of labels;
+         * it is just a wrapper around @ref _verify, which check `_ok`
+         *
+         * @param descriptors - face descriptors
+         * @param label       - an expected label
+         *
+         * @return whether the descriptor matches the label OR `false` if classifier is not `_ok`
+         */
+        bool verify(const std::vector<double> &descriptors, int label) {
+            if (!_ok) {
+                return false;
+            }
+
+            return _verify(descriptors, label);
+        }
+
         /**
          * Trains the classifier on the given samples
          *
@@ -85,6 +103,19 @@ namespace faces {
          */
         virtual int _classifyDescriptors(const std::vector<double> &descriptors) = 0;
 
+        /**
+         * Verifies that the given face descriptor belongs to the given label;
+         * the default implementation falls back to the full classification, you should override it
+         *
+         * @param descriptors - face descriptors
+         * @param label       - an expected label
+         *
+         * @return whether the descriptor matches the label
+         */
+        virtual bool _verify(const std::vector<double> &descriptors, int label) {
+            return _classifyDescriptors(descriptors) == label;
+        }
+
         /**
          * Saves the classifier to the given destination
          *
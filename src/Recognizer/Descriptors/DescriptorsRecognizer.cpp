@@ -18,11 +18,173 @@ namespace faces {
         return _ok;
     }
 
+    void DescriptorsRecognizer::_initCache(Config const &config) {
+        try {
+            _cache.configure(config["DescriptorsRecognizer.cacheCapacity"].getInt(),
+                             config["DescriptorsRecognizer.cacheTolerance"].getInt(),
+                             config["DescriptorsRecognizer.cacheMaxDifference"].getNumber());
+        } catch (std::out_of_range &e) {
+            spdlog::error("Cannot get parameters of the descriptor cache from the config, it is disabled");
+        }
+    }
+
+    void DescriptorsRecognizer::_initReplicas(Config const &config) {
+        _replicas.clear();
+
+        int threads = 1;
+        try {
+            threads = config["DescriptorsRecognizer.threads"].getInt();
+        } catch (std::out_of_range &e) {
+            spdlog::error("Cannot get an option 'DescriptorsRecognizer.threads' from the config!");
+        }
+        if (threads <= 0) {
+            threads = static_cast<int>(ThreadPool::getInstance().getThreadsCount());
+        }
+
+        if (!descriptor->isOk()) return;
+        for (int i = 1; i < threads; ++i) {
+            std::unique_ptr<Descriptor> replica(descriptor->clone());
+            if (!replica || !replica->isOk()) {
+                spdlog::warn("Cannot replicate the face descriptor, using {} recognition threads", i);
+                break;
+            }
+            _replicas.emplace_back(std::move(replica));
+        }
+    }
+
+    std::vector<double> DescriptorsRecognizer::computeDescriptor(cv::Mat const &img) {
+        if (!descriptor->isOk()) return {};
+
+        if (_cache.isEnabled()) {
+            if (std::optional<DescriptorCache::Entry> entry = _cache.find(DescriptorCache::makeKey(img))) {
+                return std::move(entry->descriptor);
+            }
+        }
+        return _computeDescriptor(img);
+    }
+
+    std::vector<double> DescriptorsRecognizer::_computeDescriptor(cv::Mat const &img) {
+        if (_service != nullptr) {
+            return _service->submit(img).get();
+        }
+        return descriptor->computeDescriptors(img);
+    }
+
+    std::vector<int> DescriptorsRecognizer::_recognizeBatch(std::vector<cv::Mat> const &imgs) {
+        if (!_checkOk()) return std::vector<int>(imgs.size(), -2);
+
+        std::vector<int> labels(imgs.size(), -1);
+        std::vector<DescriptorCache::Key> keys(imgs.size());
+        std::vector<std::size_t> misses;
+        for (std::size_t i = 0; i < imgs.size(); ++i) {
+            if (_cache.isEnabled()) {
+                keys[i] = DescriptorCache::makeKey(imgs[i]);
+                if (std::optional<DescriptorCache::Entry> entry = _cache.find(keys[i])) {
+                    labels[i] = entry->label;
+                    continue;
+                }
+            }
+            misses.emplace_back(i);
+        }
+
+        std::vector<std::vector<double>> descriptors(imgs.size());
+        if (_service != nullptr) {
+            // all of the images are queued before waiting, so they get into the same batches
+            std::vector<std::future<std::vector<double>>> futures;
+            for (std::size_t i : misses) {
+                futures.emplace_back(_service->submit(imgs[i]));
+            }
+            for (std::size_t k = 0; k < misses.size(); ++k) {
+                std::size_t i = misses[k];
+                descriptors[i] = futures[k].get();
+                labels[i] = classifier->classifyDescriptors(descriptors[i]);
+            }
+        } else {
+            // every thread takes the next missed image, writing results at its index, so the order does not change
+            std::atomic<std::size_t> next = 0;
+            auto work = [&](Descriptor *replica) {
+                for (std::size_t k = next++; k < misses.size(); k = next++) {
+                    std::size_t i = misses[k];
+                    descriptors[i] = replica->computeDescriptors(imgs[i]);
+                    labels[i] = classifier->classifyDescriptors(descriptors[i]);
+                }
+            };
+
+            std::size_t threads = std::min(_replicas.size() + 1, misses.size());
+            ThreadPool::getInstance().parallel(threads, [&](std::size_t t) {
+                work(t == 0 ? descriptor : _replicas[t - 1].get());
+            });
+        }
+
+        if (_cache.isEnabled()) {
+            for (std::size_t i : misses) {
+                _cache.insert(std::move(keys[i]), std::move(descriptors[i]), labels[i]);
+            }
+        }
+        return labels;
+    }
+
     int DescriptorsRecognizer::_recognize(cv::Mat const &img) {
-        if (!_checkOk()) return -2;
+        return _verifyOrRecognize(img, -1);
+    }
+
+    int DescriptorsRecognizer::_verifyOrRecognize(cv::Mat const &img, int expectedLabel) {
+        Face face(img, {});
+        return _recognizeFace(face, expectedLabel);
+    }
 
-        std::vector<double> descriptors = descriptor->computeDescriptors(img);
-        return classifier->classifyDescriptors(descriptors);
+    int DescriptorsRecognizer::_recognizeFace(Face &face, int expectedLabel) {
+        return _recognizeFaces({&face}, {expectedLabel}).front();
+    }
+
+    std::vector<int> DescriptorsRecognizer::_recognizeFaces(std::vector<Face *> const &faces,
+                                                            std::vector<int> const &expectedLabels) {
+        if (!_checkOk()) return std::vector<int>(faces.size(), -2);
+
+        std::vector<int> labels(faces.size(), -1);
+        std::vector<DescriptorCache::Key> keys(faces.size());
+        std::vector<std::size_t> misses;
+        for (std::size_t i = 0; i < faces.size(); ++i) {
+            Face &face = *faces[i];
+            if (_cache.isEnabled()) {
+                keys[i] = DescriptorCache::makeKey(face.img);
+                if (face.descriptor.empty()) {
+                    if (std::optional<DescriptorCache::Entry> entry = _cache.find(keys[i])) {
+                        face.descriptor = std::move(entry->descriptor);
+                        labels[i] = entry->label;
+                        continue;
+                    }
+                }
+            }
+            misses.emplace_back(i);
+        }
+
+        if (_service != nullptr) {
+            // all of the faces are queued before waiting, so they get into the same batches
+            std::vector<std::pair<std::size_t, std::future<std::vector<double>>>> futures;
+            for (std::size_t i : misses) {
+                if (faces[i]->descriptor.empty()) {
+                    futures.emplace_back(i, _service->submit(faces[i]->img));
+                }
+            }
+            for (auto &future : futures) {
+                faces[future.first]->descriptor = future.second.get();
+            }
+        }
+
+        for (std::size_t i : misses) {
+            Face &face = *faces[i];
+            if (face.descriptor.empty()) {
+                face.descriptor = descriptor->computeDescriptors(face.img);
+            }
+            labels[i] = expectedLabels[i] >= 0 && classifier->verify(face.descriptor, expectedLabels[i])
+                        ? expectedLabels[i] : classifier->classifyDescriptors(face.descriptor);
+
+            if (_cache.isEnabled()) {
+                _cache.insert(std::move(keys[i]), face.descriptor, labels[i]);
+            }
+        }
+        return labels;
     }
 
     void DescriptorsRecognizer::train(std::map<int, cv::Mat &> const &samples) {
@@ -30,10 +192,11 @@ namespace faces {
 
         std::map<int, std::vector<double>> descriptorSamples;
         for (auto const &sample : samples) {
-            descriptorSamples[sample.first] = descriptor->computeDescriptors(sample.second);
+            descriptorSamples[sample.first] = _computeDescriptor(sample.second);
         }
 
         classifier->train(descriptorSamples);
+        _cache.clear();
         _checkOk();
     }
 
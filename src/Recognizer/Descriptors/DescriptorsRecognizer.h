@@ -11,11 +11,18 @@
 #define FACES_DESCRIPTORSRECOGNIZER_H
 
 #include <type_traits>
+#include <memory>
+#include <atomic>
+
+#include <Config/Config.h>
+#include <utils/ThreadPool.h>
 
 #include "../Recognizer.hpp"
 
 #include "Descriptor.hpp"
 #include "DescriptorsClassifier.hpp"
+#include "DescriptorCache.h"
+#include "DescriptorService.h"
 
 namespace faces {
 
@@ -48,7 +55,80 @@ namespace faces {
          */
         void train(std::map<int, cv::Mat &> const &samples) override;
 
+        /**
+         * Computes a descriptor of the given face image the same way as the recognition does:
+         * it is taken from the cache OR computed with the service, if they are set,
+         * so it is safe to call along with the recognition
+         *
+         * @param img - a photo of the face
+         *
+         * @return the descriptor OR an empty vector if the `descriptor` is not ok
+         */
+        std::vector<double> computeDescriptor(cv::Mat const &img);
+
+        /**
+         * @return a number of parallel tasks of the batch recognition, each with its own descriptor replica;
+         *         they run on the ThreadPool
+         */
+        [[nodiscard]] std::size_t getThreadsCount() const {
+            return _replicas.size() + 1;
+        }
+
+        /**
+         * @return the cache of descriptors, which keeps hit/miss counters
+         */
+        [[nodiscard]] DescriptorCache const &getCache() const {
+            return _cache;
+        }
+
+        /**
+         * Makes the recognizer compute all of the descriptors with the given service instead of the `descriptor`
+         * and its replicas, so the faces of several recognizers (e.g. of different streams or workers)
+         * are computed in shared batches
+         *
+         * @param service - a service over the `descriptor` or a compatible one OR nullptr to compute them here;
+         *                  it is not owned by this class and should outlive the recognizer
+         */
+        void setDescriptorService(DescriptorService *service) {
+            _service = service;
+        }
+
+        /**
+         * @return the service, which computes the descriptors, with its batching metrics OR nullptr if it is not set
+         */
+        [[nodiscard]] DescriptorService const *getDescriptorService() const {
+            return _service;
+        }
+
     protected:
+        /// a cache of the recognition results, disabled by default; it is shared by the threads
+        DescriptorCache _cache;
+
+        /// a service, which computes the descriptors instead of the `descriptor`, if it is set
+        DescriptorService *_service = nullptr;
+
+        /// replicas of the `descriptor` for the additional threads of the batch recognition
+        std::vector<std::unique_ptr<Descriptor>> _replicas;
+
+        /**
+         * Clones the `descriptor` to use the number of threads given in the config for the batch recognition;
+         * it should be called in the derived class` constructor after the `descriptor` is created. @n
+         * Each replica runs the network on a worker of the ThreadPool, so the descriptor`s own threading
+         * (BLAS threads) should be limited to avoid oversubscribing the cores; opencv ones by ThreadPool.opencvThreads
+         */
+        void _initReplicas(Config const &config);
+
+        /**
+         * Creates the descriptor cache with parameters from the config;
+         * it should be called in the derived class` constructor to enable the cache
+         */
+        void _initCache(Config const &config);
+
+        /**
+         * Computes a descriptor of the given face image with the service, if it is set, or with the `descriptor`
+         */
+        std::vector<double> _computeDescriptor(cv::Mat const &img);
+
         /**
          * Sets this class` `_ok` value base on states of `descriptor` and `classifier`
          *
@@ -58,6 +138,7 @@ namespace faces {
 
         /**
          * Estimates a label by generating a descriptor for the given face image and classifying it;
+         * if the cache is enabled, a label of a near-identical image is reused instead.
          * It works only when both `descriptor` and `classifier` are ok
          *
          * @param img - a photo of the face
@@ -65,8 +146,53 @@ namespace faces {
          * @returns a label of the face
          */
         int _recognize(cv::Mat const &img) override;
+
+        /**
+         * Looks the images up in the cache, then computes descriptors of the missed ones
+         * and classifies them on the replicas in parallel, or submits all of them to the service at once;
+         * the classifier is shared by the threads, so it should be safe to call concurrently
+         */
+        std::vector<int> _recognizeBatch(std::vector<cv::Mat> const &imgs) override;
+
+        /**
+         * Generates a descriptor for the given face image and verifies it against the expected label
+         * with DescriptorsClassifier::verify, falling back to the full classification if it does not match
+         */
+        int _verifyOrRecognize(cv::Mat const &img, int expectedLabel) override;
+
+        /**
+         * Recognizes the face the same way as @ref _verifyOrRecognize,
+         * but reuses Face::descriptor if it is already computed and stores the computed one there
+         */
+        int _recognizeFace(Face &face, int expectedLabel) override;
+
+        /**
+         * Recognizes each of the faces the same way as @ref _recognizeFace; if the service is set,
+         * all of the missed faces are submitted to it before waiting for any, so they share its batches
+         */
+        std::vector<int> _recognizeFaces(std::vector<Face *> const &faces,
+                                         std::vector<int> const &expectedLabels) override;
     };
 
+    FACES_AUGMENT_CONFIG(DescriptorsRecognizer,
+                         FACES_ADD_CONFIG_OPTION("DescriptorsRecognizer.cacheCapacity", "descriptorCacheCapacity",
+                                                 0, false, "A maximal number of cached face descriptors, "
+                                                           "0 disables the cache")
+                                 FACES_ADD_CONFIG_OPTION("DescriptorsRecognizer.cacheTolerance",
+                                                         "descriptorCacheTolerance", 4, false,
+                                                         "A maximal Hamming distance between perceptual hashes "
+                                                         "of face images to reuse a cached descriptor")
+                                 FACES_ADD_CONFIG_OPTION("DescriptorsRecognizer.cacheMaxDifference",
+                                                         "descriptorCacheMaxDifference", 8, false,
+                                                         "A maximal mean absolute difference between grayscale "
+                                                         "16x16 thumbnails of face images with matching hashes "
+                                                         "to reuse a cached descriptor")
+                                 FACES_ADD_CONFIG_OPTION("DescriptorsRecognizer.threads", "recognitionThreads", 1,
+                                                         false, "A number of threads (and descriptor replicas) "
+                                                                "to recognize faces in parallel, "
+                                                                "0 to use all of the threads of the ThreadPool")
+    )
+
 }
 
 #endif //FACES_DESCRIPTORSRECOGNIZER_H
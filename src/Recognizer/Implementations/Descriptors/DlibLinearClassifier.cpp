@@ -0,0 +1,165 @@
+/**
+ * @file DlibLinearClassifier.cpp
+ * @author Люнгрин Андрей aka prostoichelovek <iam.prostoi.chelovek@gmail.ru>
+ * @date 19 Oct 2026
+ * @copyright MIT License
+ */
+
+#include "DlibLinearClassifier.h"
+
+#include <limits>
+
+namespace faces {
+
+    DlibLinearClassifier::DlibLinearClassifier(Config const &config) {
+        std::string const &classifierFile = config.getDataPath("DlibLinearClassifier.classifier");
+        _load(classifierFile);
+
+        try {
+            get_threshold() = config["DlibLinearClassifier.threshold"].getNumber();
+            verifyMargin = config["DlibLinearClassifier.verifyMargin"].getNumber();
+        } catch (std::out_of_range &e) {
+            spdlog::error("Cannot get thresholds of the DlibLinearClassifier from the config!");
+        }
+    }
+
+    DlibLinearClassifier::DlibLinearClassifier(std::string const &classifierFile) {
+        _load(classifierFile);
+    }
+
+    void DlibLinearClassifier::train(std::map<int, std::vector<double>> const &samples) {
+        std::vector<dlibLinear::SampleType> descriptors;
+        std::vector<int> labels;
+
+        for (auto const &sample : samples) {
+            labels.emplace_back(sample.first);
+            descriptors.emplace_back(dlib::mat(sample.second));
+        }
+
+        if (labels.size() < 2) {
+            spdlog::error("Cannot train a linear descriptor classifier on less than two labels");
+            return;
+        }
+
+        dlibLinear::TrainerType trainer;
+        trainer.set_c(10);
+        auto function = trainer.train(descriptors, labels);
+
+        _labels = function.labels;
+        _weights = function.weights;
+        _biases = function.b;
+        _indexLabels();
+        _calibrate(descriptors, labels);
+
+        _ok = !_labels.empty();
+    }
+
+    int DlibLinearClassifier::_classifyDescriptors(const std::vector<double> &descriptors) {
+        long best;
+        double margin;
+        if (!_findBest(descriptors, best, margin)) {
+            return -1;
+        }
+        return margin < get_threshold() ? -1 : _labels[best];
+    }
+
+    bool DlibLinearClassifier::_verify(const std::vector<double> &descriptors, int label) {
+        if (_verifyScores.size() != _weights.nr()) {
+            return _classifyDescriptors(descriptors) == label;
+        }
+
+        auto it = _labelRows.find(label);
+        if (it == _labelRows.end() || static_cast<long>(descriptors.size()) != _weights.nc()) {
+            return false;
+        }
+
+        long row = it->second;
+        double score = -_biases(row);
+        for (long d = 0; d < _weights.nc(); ++d) {
+            score += _weights(row, d) * descriptors[d];
+        }
+        return score - _verifyScores(row) >= verifyMargin;
+    }
+
+    bool DlibLinearClassifier::_save(std::string const &dst) {
+        try {
+            dlib::serialize(dst) << _labels << _weights << _biases << _verifyScores;
+            return true;
+        } catch (dlib::serialization_error &e) {
+            spdlog::error("Cannot save a linear descriptor classifier to {}: {}", dst, e.what());
+            return false;
+        }
+    }
+
+    bool DlibLinearClassifier::_load(std::string const &classifierFile) {
+        try {
+            auto file = dlib::deserialize(classifierFile);
+            file >> _labels >> _weights >> _biases;
+            _indexLabels();
+
+            // the classifiers saved before the calibration have no thresholds
+            _verifyScores.set_size(0);
+            try {
+                file >> _verifyScores;
+            } catch (dlib::serialization_error &e) {
+                spdlog::warn("A linear descriptor classifier from {} has no verification thresholds, "
+                             "the faces are classified to verify them", classifierFile);
+                _verifyScores.set_size(0);
+            }
+
+            _ok = true;
+            if (_labels.empty() || _weights.nr() != static_cast<long>(_labels.size())
+                || _biases.size() != _weights.nr()) {
+                spdlog::error("A linear descriptor classifier was loaded without errors from file {}, "
+                              "however it is empty or malformed!", classifierFile);
+                _ok = false;
+            }
+        } catch (dlib::serialization_error &e) {
+            spdlog::error("Cannot load a linear descriptor classifier from {}: {}", classifierFile, e.what());
+            _ok = false;
+        }
+        return _ok;
+    }
+
+    bool DlibLinearClassifier::_findBest(const std::vector<double> &descriptors, long &best, double &margin) const {
+        if (_labels.empty() || static_cast<long>(descriptors.size()) != _weights.nc()) {
+            return false;
+        }
+
+        dlib::matrix<double, 0, 1> scores = _weights * dlib::mat(descriptors) - _biases;
+
+        best = dlib::index_of_max(scores);
+        double bestScore = scores(best);
+        if (scores.size() == 1) {
+            margin = bestScore;
+            return true;
+        }
+
+        scores(best) = -std::numeric_limits<double>::infinity();
+        margin = bestScore - dlib::max(scores);
+        return true;
+    }
+
+    void DlibLinearClassifier::_calibrate(std::vector<dlibLinear::SampleType> const &descriptors,
+                                          std::vector<int> const &labels) {
+        _verifyScores.set_size(_weights.nr());
+        for (long row = 0; row < _weights.nr(); ++row) {
+            double own = -std::numeric_limits<double>::infinity();
+            double other = -std::numeric_limits<double>::infinity();
+            for (std::size_t i = 0; i < descriptors.size(); ++i) {
+                double score = dlib::dot(dlib::trans(dlib::rowm(_weights, row)), descriptors[i]) - _biases(row);
+                double &best = labels[i] == _labels[row] ? own : other;
+                best = std::max(best, score);
+            }
+            _verifyScores(row) = (own + other) / 2;
+        }
+    }
+
+    void DlibLinearClassifier::_indexLabels() {
+        _labelRows.clear();
+        for (std::size_t row = 0; row < _labels.size(); ++row) {
+            _labelRows[_labels[row]] = row;
+        }
+    }
+
+}
@@ -0,0 +1,133 @@
+/**
+ * @file DlibLinearClassifier.h
+ * @author Люнгрин Андрей aka prostoichelovek <iam.prostoi.chelovek@gmail.ru>
+ * @date 19 Oct 2026
+ * @copyright MIT License
+ *
+ * @brief This file contains a descriptors classifier based on a multiclass linear SVM
+ */
+
+#ifndef FACES_DLIBLINEARCLASSIFIER_H
+#define FACES_DLIBLINEARCLASSIFIER_H
+
+#include <unordered_map>
+
+#include <dlib/svm_threaded.h>
+
+#include <spdlog/spdlog.h>
+
+#include <Config/Config.h>
+
+#include <Recognizer/Descriptors/DescriptorsClassifier.hpp>
+
+namespace faces {
+
+    namespace dlibLinear {
+        using SampleType = dlib::matrix<double, 0, 1>;
+        using KernelType = dlib::linear_kernel<SampleType>;
+        using TrainerType = dlib::svm_multiclass_linear_trainer<KernelType, int>;
+    }
+
+    /**
+     * An implementation of descriptors classifier based on a multiclass linear SVM. @n
+     * It is a single multiclass SVM trained jointly over all of the labels (not a set of binary ones),
+     * so its training cost grows linearly with the number of labels, unlike the one vs one DlibSvmClassifier,
+     * and the classification is a single (labels x descriptor size) matrix-vector product. @n
+     * The raw scores are not comparable between faces, so the `threshold` is a minimal margin of the best score
+     * over the second best one; the training makes the margin of the training samples at least 1. @n
+     * The verification is a single dot product with the row of the expected label, so its cost does not depend
+     * on the number of labels; the score of each row is compared with a threshold calibrated by the training
+     */
+    class DlibLinearClassifier : public DescriptorsClassifier {
+    public:
+        FACES_OVERRIDE_ATTRIBUTE(threshold, 0.5)
+
+        FACES_MAIN_CONSTRUCTOR(explicit DlibLinearClassifier, Config const &config);
+
+        explicit DlibLinearClassifier(std::string const &classifierFile);
+
+        /// a minimal margin of the score of the expected label over its calibrated threshold to verify it
+        double verifyMargin = 0;
+
+        void train(std::map<int, std::vector<double>> const &samples) override;
+
+    protected:
+        int _classifyDescriptors(const std::vector<double> &descriptors) override;
+
+        /**
+         * Verifies the label in O(descriptor size) by the score of its row only, which should exceed
+         * the calibrated threshold of the row (see @ref _verifyScores) by @ref verifyMargin. @n
+         * The classifiers saved without the thresholds have no fast path, so the face is classified
+         */
+        bool _verify(const std::vector<double> &descriptors, int label) override;
+
+        /**
+         * Saves the labels, weights, biases and the verification thresholds in the dlib`s binary format
+         */
+        bool _save(std::string const &dst) override;
+
+        /**
+         * Deserializes the classifier from the given file
+         *
+         * @param classifierFile - a file with the classifier, created in the @ref _save method
+         *
+         * @return successfulness of the deserialization = current _ok
+         */
+        bool _load(std::string const &classifierFile);
+
+    private:
+        /// a label of each row of the @ref _weights
+        std::vector<int> _labels;
+        /// {label: row of the @ref _weights}
+        std::unordered_map<int, long> _labelRows;
+
+        /// a (labels x descriptor size) matrix of the weights
+        dlib::matrix<double> _weights;
+
+        /// a bias of each label
+        dlib::matrix<double, 0, 1> _biases;
+
+        /// a minimal score of each row to verify its label: the middle between the score of the training sample
+        /// of the label and the best score of the samples of the other labels; empty if it is unknown
+        dlib::matrix<double, 0, 1> _verifyScores;
+
+        /**
+         * Fills the @ref _labelRows
+         */
+        void _indexLabels();
+
+        /**
+         * Finds the label with the best score
+         *
+         * @param descriptors - face descriptors
+         * @param best        - a destination of a row of the best label
+         * @param margin      - a destination of a margin of the best score over the second best one,
+         *                      or of the score itself if there is a single label
+         *
+         * @return false if the descriptors do not fit the classifier
+         */
+        bool _findBest(const std::vector<double> &descriptors, long &best, double &margin) const;
+
+        /**
+         * Fills the @ref _verifyScores by the training samples
+         */
+        void _calibrate(std::vector<dlibLinear::SampleType> const &descriptors, std::vector<int> const &labels);
+
+    };
+
+    FACES_REGISTER_SUBCLASS(DescriptorsClassifier, DlibLinearClassifier, DlibLinear)
+
+    FACES_AUGMENT_CONFIG(DlibLinearClassifier,
+                         FACES_ADD_CONFIG_OPTION("DlibLinearClassifier.classifier", "linearClassifier", "", false,
+                                                 "A path to a model file of Dlib-based linear SVM face descriptor classifier")
+                                 FACES_ADD_CONFIG_OPTION("DlibLinearClassifier.threshold", "linearThreshold", 0.5,
+                                                         false, "A minimal margin of the best score of a label "
+                                                                "over the second best one to accept it")
+                                 FACES_ADD_CONFIG_OPTION("DlibLinearClassifier.verifyMargin", "linearVerifyMargin",
+                                                         0, false, "A minimal margin of the score of the expected "
+                                                                   "label over its calibrated threshold "
+                                                                   "to verify a face"))
+
+}
+
+#endif //FACES_DLIBLINEARCLASSIFIER_H
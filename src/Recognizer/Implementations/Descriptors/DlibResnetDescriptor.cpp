@@ -18,6 +18,10 @@ namespace faces {
         _load(model);
     }
 
+    Descriptor *DlibResnetDescriptor::clone() const {
+        return new DlibResnetDescriptor(*this);
+    }
+
     std::vector<double> DlibResnetDescriptor::_computeDescriptors(cv::Mat const &faceImg) {
         dlib::cv_image<dlib::rgb_pixel> dFaceImg;
         cv::Mat rgbImg;
@@ -40,9 +44,33 @@ namespace faces {
         return std::vector<double>(descriptor.begin(), descriptor.end());
     }
 
+    std::vector<std::vector<double>> DlibResnetDescriptor::_computeDescriptorsBatch(
+            std::vector<cv::Mat> const &faceImgs) {
+        if (faceImgs.empty()) {
+            return {};
+        }
+
+        // dlib`s images only wrap the opencv ones, so the converted images should outlive them
+        std::vector<cv::Mat> rgbImgs(faceImgs.size());
+        std::vector<dlib::cv_image<dlib::rgb_pixel>> dFaceImgs;
+        for (std::size_t i = 0; i < faceImgs.size(); ++i) {
+            cv::cvtColor(faceImgs[i], rgbImgs[i], cv::COLOR_BGR2RGB);
+            dFaceImgs.emplace_back(rgbImgs[i]);
+        }
+
+        std::vector<dlib::matrix<float, 0, 1>> faceDescriptors = _descriptor(dFaceImgs, dFaceImgs.size());
+
+        std::vector<std::vector<double>> res;
+        for (auto const &desc : faceDescriptors) {
+            res.emplace_back(desc.begin(), desc.end());
+        }
+        return res;
+    }
+
     bool DlibResnetDescriptor::_load(std::string const &src) {
         try {
             dlib::deserialize(src) >> _descriptor;
+            _dimension = dlibResnet::DescriptorType::NR;
             _ok = true;
         } catch (dlib::serialization_error &e) {
             spdlog::error("Cannot load a dlib face descriptor from {}: {}", src, e.what());
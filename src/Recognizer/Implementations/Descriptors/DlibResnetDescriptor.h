@@ -85,11 +85,25 @@ namespace faces {
 
         explicit DlibResnetDescriptor(std::string const &model);
 
+        /**
+         * Copies the network with its loaded weights, so the replica has its own intermediate tensors
+         */
+        [[nodiscard]] Descriptor *clone() const override;
+
     protected:
         FACES_OVERRIDE_ATTRIBUTE(faceSize, 150, 150)
 
+        /// the network is trained so the faces of the same person are closer than 0.6
+        FACES_OVERRIDE_ATTRIBUTE(metric, Metric::Euclidean)
+        FACES_OVERRIDE_ATTRIBUTE(matchDistance, 0.6)
+
         std::vector<double> _computeDescriptors(cv::Mat const &faceImg) override;
 
+        /**
+         * Forwards the whole batch through the network at once
+         */
+        std::vector<std::vector<double>> _computeDescriptorsBatch(std::vector<cv::Mat> const &faceImgs) override;
+
         /**
          * Deserializes descriptor net from the given .dat file
          *
@@ -0,0 +1,40 @@
+/**
+ * @file DlibResnetLinearRecognizer.h
+ * @author Люнгрин Андрей aka prostoichelovek <iam.prostoi.chelovek@gmail.ru>
+ * @date 19 Oct 2026
+ * @copyright MIT License
+ *
+ * @brief This file contains a descriptor-based face recognizer with dlib`s ResNet and a multiclass linear SVM
+ */
+
+#ifndef FACES_DLIBRESNETLINEARRECOGNIZER_H
+#define FACES_DLIBRESNETLINEARRECOGNIZER_H
+
+#include <Recognizer/Descriptors/DescriptorsRecognizer.h>
+#include <Config/Config.h>
+#include "DlibResnetDescriptor.h"
+#include "DlibLinearClassifier.h"
+
+namespace faces {
+
+    /**
+     * An implementation of the descriptor-based face recognizer,
+     * which uses dlib`s ResNet-based descriptor and a multiclass linear SVM classifier
+     */
+    class DlibResnetLinearRecognizer : public DescriptorsRecognizer {
+    public:
+        FACES_MAIN_CONSTRUCTOR(explicit DlibResnetLinearRecognizer, Config const &config) {
+            descriptor = FACES_CREATE_INSTANCE(Descriptor, DlibResnet, config);
+            classifier = FACES_CREATE_INSTANCE(DescriptorsClassifier, DlibLinear, config);
+            _initCache(config);
+            _initReplicas(config);
+            _checkOk();
+        }
+
+    };
+
+    FACES_REGISTER_SUBCLASS(Recognizer, DlibResnetLinearRecognizer, DlibResnetLinear)
+
+}
+
+#endif //FACES_DLIBRESNETLINEARRECOGNIZER_H
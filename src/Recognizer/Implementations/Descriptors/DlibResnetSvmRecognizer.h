@@ -26,6 +26,8 @@ namespace faces {
         FACES_MAIN_CONSTRUCTOR(explicit DlibResnetSvmRecognizer, Config const &config) {
             descriptor = FACES_CREATE_INSTANCE(Descriptor, DlibResnet, config);
             classifier = FACES_CREATE_INSTANCE(DescriptorsClassifier, DlibSvm, config);
+            _initCache(config);
+            _initReplicas(config);
             _checkOk();
         }
 
@@ -5,20 +5,32 @@
  * @copyright MIT License
  */
 
+#include <cmath>
+#include <limits>
+#include <set>
+
 #include "DlibSvmClassifier.h"
 #include "DlibResnetDescriptor.h"
 
 faces::DlibSvmClassifier::DlibSvmClassifier(Config const &config) {
     std::string const &classifiersFile = config.getDataPath("DlibSvmClassifier.classifiers");
     _load(classifiersFile);
+
+    try {
+        verifyDistance = config["DlibSvmClassifier.verifyDistance"].getNumber();
+    } catch (std::out_of_range &e) {
+        spdlog::error("Cannot get an option 'DlibSvmClassifier.verifyDistance' from the config!");
+    }
 }
 
-faces::DlibSvmClassifier::DlibSvmClassifier(std::string const &classifiersFile) {
+faces::DlibSvmClassifier::DlibSvmClassifier(std::string const &classifiersFile, double verifyDistance,
+                                            Descriptor::Metric verifyMetric)
+        : verifyDistance(verifyDistance), verifyMetric(verifyMetric) {
     _load(classifiersFile);
 }
 
 void faces::DlibSvmClassifier::train(std::map<int, std::vector<double>> const &samples) {
-    std::vector<dlibResnet::DescriptorType> descriptors;
+    std::vector<dlibSvm::SampleType> descriptors;
     std::vector<int> labels;
 
     for (auto const &sample : samples) {
@@ -48,7 +60,7 @@ void faces::DlibSvmClassifier::train(std::map<int, std::vector<double>> const &s
     // Train and init classifiers ->
     int label1 = 0, label2 = 1;
     for (dlibSvm::TrainerType &trainer : trainers) {
-        std::vector<dlibResnet::DescriptorType> samples4Pair;
+        std::vector<dlibSvm::SampleType> samples4Pair;
         std::vector<double> labels4Pair;
 
         for (int i = 0; i < descriptors.size(); i++) {
@@ -74,26 +86,16 @@ void faces::DlibSvmClassifier::train(std::map<int, std::vector<double>> const &s
     }
     // <- Train and init classifiers
 
+    _packed.compile(_classifiers);
     _ok = !_classifiers.empty();
 }
 
 int faces::DlibSvmClassifier::_classifyDescriptors(const std::vector<double> &descriptors) {
-    std::map<double, int> votes;
-    for (auto &faceClassifier : _classifiers) {
-        dlibResnet::DescriptorType dlibDescriptors = dlib::mat(descriptors);
-        double prediction = faceClassifier.classify(dlibDescriptors, get_threshold());
-        if (prediction == -1)
-            continue;
-        votes[prediction]++;
-    }
-
-    auto max = std::max_element(votes.begin(), votes.end(),
-                                [](const std::pair<int, int> &p1, const std::pair<int, int> &p2) {
-                                    return p1.second < p2.second;
-                                });
+    return _packed.classify(descriptors, get_threshold());
+}
 
-    int label = votes.empty() ? -1 : max->first;
-    return label;
+bool faces::DlibSvmClassifier::_verify(const std::vector<double> &descriptors, int label) {
+    return _packed.verify(descriptors, label, verifyDistance, verifyMetric);
 }
 
 bool faces::DlibSvmClassifier::_save(std::string const &dst) {
@@ -109,6 +111,7 @@ bool faces::DlibSvmClassifier::_save(std::string const &dst) {
 bool faces::DlibSvmClassifier::_load(std::string const &classifiersFile) {
     try {
         dlib::deserialize(classifiersFile) >> _classifiers;
+        _packed.compile(_classifiers);
         _ok = true;
         if (_classifiers.empty()) {
             spdlog::error("Descriptor classifiers were loaded without errors from file {}, "
@@ -121,3 +124,189 @@ bool faces::DlibSvmClassifier::_load(std::string const &classifiersFile) {
     }
     return _ok;
 }
+
+
+void faces::dlibSvm::PackedSvmClassifiers::compile(std::vector<SingleSvmClassifier> const &classifiers) {
+    *this = PackedSvmClassifiers();
+
+    // Unique labels ->
+    for (auto const &classifier : classifiers) {
+        _labels.emplace_back(classifier.negativeLabel);
+        _labels.emplace_back(classifier.positiveLabel);
+    }
+    std::sort(_labels.begin(), _labels.end());
+    _labels.erase(std::unique(_labels.begin(), _labels.end()), _labels.end());
+    for (std::uint32_t i = 0; i < _labels.size(); ++i) {
+        _labelIndexes[_labels[i]] = i;
+    }
+    auto labelIdx = [&](int label) -> std::uint32_t {
+        return _labelIndexes.at(label);
+    };
+    // <- Unique labels
+
+    // Deduplicate support vectors ->
+    std::map<std::vector<double>, std::uint32_t> vectorIndexes;
+    std::vector<std::vector<double> const *> uniqueVectors;
+
+    _termOffsets.emplace_back(0);
+    for (auto const &classifier : classifiers) {
+        auto const &function = classifier.classifier;
+        for (long i = 0; i < function.basis_vectors.size(); ++i) {
+            auto const &basisVector = function.basis_vectors(i);
+            std::vector<double> key(basisVector.begin(), basisVector.end());
+
+            auto [it, inserted] = vectorIndexes.emplace(std::move(key), uniqueVectors.size());
+            if (inserted) {
+                uniqueVectors.emplace_back(&it->first);
+            }
+
+            _termVectors.emplace_back(it->second);
+            _termAlphas.emplace_back(function.alpha(i));
+        }
+        _termOffsets.emplace_back(_termVectors.size());
+
+        _biases.emplace_back(function.b);
+        _negativeLabels.emplace_back(labelIdx(classifier.negativeLabel));
+        _positiveLabels.emplace_back(labelIdx(classifier.positiveLabel));
+    }
+    // <- Deduplicate support vectors
+
+    // Pack support vectors ->
+    _dimension = uniqueVectors.empty() ? 0 : uniqueVectors.front()->size();
+    _stride = (_dimension + _simdWidth - 1) / _simdWidth * _simdWidth;
+
+    // the padding of both the query and the vectors is zero, so min(query, vector) is zero there
+    _supportVectors.assign(uniqueVectors.size() * _stride, 0.0);
+    for (std::size_t i = 0; i < uniqueVectors.size(); ++i) {
+        std::copy(uniqueVectors[i]->begin(), uniqueVectors[i]->end(), _supportVectors.begin() + i * _stride);
+    }
+    // <- Pack support vectors
+
+    // Label centroids ->
+    // a sign of the weight of a support vector tells which side of the pairwise classifier it belongs to
+    std::vector<std::set<std::uint32_t>> labelVectors(_labels.size());
+    for (std::size_t c = 0; c < _biases.size(); ++c) {
+        for (std::size_t t = _termOffsets[c]; t < _termOffsets[c + 1]; ++t) {
+            std::uint32_t label = _termAlphas[t] < 0 ? _negativeLabels[c] : _positiveLabels[c];
+            labelVectors[label].insert(_termVectors[t]);
+        }
+    }
+
+    _centroids.assign(_labels.size() * _dimension, 0.0);
+    for (std::size_t l = 0; l < _labels.size(); ++l) {
+        double *centroid = _centroids.data() + l * _dimension;
+        for (std::uint32_t vectorIdx : labelVectors[l]) {
+            std::vector<double> const &supportVector = *uniqueVectors[vectorIdx];
+            for (std::size_t d = 0; d < _dimension; ++d) {
+                centroid[d] += supportVector[d] / labelVectors[l].size();
+            }
+        }
+    }
+    // <- Label centroids
+}
+
+int faces::dlibSvm::PackedSvmClassifiers::classify(std::vector<double> const &descriptor,
+                                                   double threshold) const {
+    if (empty() || descriptor.size() != _dimension) {
+        return -1;
+    }
+
+    // scratch buffers are reused between calls, but they are not shared between threads
+    thread_local std::vector<double> query, kernel, exactKernel;
+    thread_local std::vector<unsigned int> votes;
+
+    query.assign(_stride, 0.0);
+    std::copy(descriptor.begin(), descriptor.end(), query.begin());
+
+    // Evaluate the histogram intersection kernel once per unique support vector ->
+    std::size_t const numVectors = _stride == 0 ? 0 : _supportVectors.size() / _stride;
+    kernel.resize(numVectors);
+    for (std::size_t i = 0; i < numVectors; ++i) {
+        double const *supportVector = _supportVectors.data() + i * _stride;
+
+        // each lane sums its own part of the dimensions, and the lanes are added at the end
+        dlib::simd4d sum(0), queryPart, vectorPart;
+        for (std::size_t d = 0; d < _stride; d += _simdWidth) {
+            queryPart.load(query.data() + d);
+            vectorPart.load(supportVector + d);
+            sum += dlib::min(queryPart, vectorPart);
+        }
+        kernel[i] = dlib::sum(sum);
+    }
+    // <- Evaluate the histogram intersection kernel once per unique support vector
+
+    // the kernel in the order of dlib::histogram_intersection_kernel, NaN until it is needed
+    exactKernel.assign(numVectors, std::numeric_limits<double>::quiet_NaN());
+    auto getExactKernel = [this, &descriptor](std::uint32_t vectorIdx) {
+        double &value = exactKernel[vectorIdx];
+        if (std::isnan(value)) {
+            double const *supportVector = _supportVectors.data() + vectorIdx * _stride;
+            value = 0;
+            for (std::size_t d = 0; d < _dimension; ++d) {
+                value += std::min(descriptor[d], supportVector[d]);
+            }
+        }
+        return value;
+    };
+
+    // Vote ->
+    votes.assign(_labels.size(), 0);
+    for (std::size_t c = 0; c < _biases.size(); ++c) {
+        // the bias is subtracted after the sum, as in dlib::decision_function
+        double prediction = 0;
+        for (std::size_t t = _termOffsets[c]; t < _termOffsets[c + 1]; ++t) {
+            prediction += _termAlphas[t] * kernel[_termVectors[t]];
+        }
+        prediction -= _biases[c];
+
+        // the order of the sums may flip only the decisions at the threshold
+        if (std::fabs(std::fabs(prediction) - threshold) <= _exactMargin
+            || std::fabs(prediction) <= _exactMargin) {
+            prediction = 0;
+            for (std::size_t t = _termOffsets[c]; t < _termOffsets[c + 1]; ++t) {
+                prediction += _termAlphas[t] * getExactKernel(_termVectors[t]);
+            }
+            prediction -= _biases[c];
+        }
+
+        if (fabs(prediction) < threshold)
+            continue;
+        votes[prediction < 0 ? _negativeLabels[c] : _positiveLabels[c]]++;
+    }
+    // <- Vote
+
+    auto max = std::max_element(votes.begin(), votes.end());
+    if (max == votes.end() || *max == 0) {
+        return -1;
+    }
+    return _labels[std::distance(votes.begin(), max)];
+}
+
+bool faces::dlibSvm::PackedSvmClassifiers::verify(std::vector<double> const &descriptor, int label,
+                                                  double maxDistance, Descriptor::Metric metric) const {
+    auto it = _labelIndexes.find(label);
+    if (it == _labelIndexes.end() || descriptor.size() != _dimension) {
+        return false;
+    }
+
+    double const *centroid = _centroids.data() + it->second * _dimension;
+    if (metric == Descriptor::Metric::Cosine) {
+        double dot = 0, descriptorNorm = 0, centroidNorm = 0;
+        for (std::size_t d = 0; d < _dimension; ++d) {
+            dot += descriptor[d] * centroid[d];
+            descriptorNorm += descriptor[d] * descriptor[d];
+            centroidNorm += centroid[d] * centroid[d];
+        }
+        if (descriptorNorm == 0 || centroidNorm == 0) {
+            return false;
+        }
+        return 1 - dot / std::sqrt(descriptorNorm * centroidNorm) <= maxDistance;
+    }
+
+    double distance = 0;
+    for (std::size_t d = 0; d < _dimension; ++d) {
+        double diff = descriptor[d] - centroid[d];
+        distance += diff * diff;
+    }
+    return distance <= maxDistance * maxDistance;
+}
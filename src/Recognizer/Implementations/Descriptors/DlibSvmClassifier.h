@@ -8,6 +8,11 @@
 #ifndef FACES_DLIBSVMCLASSIFIER_H
 #define FACES_DLIBSVMCLASSIFIER_H
 
+#include <cstdint>
+#include <unordered_map>
+
+#include <dlib/simd.h>
+
 #include "DlibResnetDescriptor.h"
 #include <Recognizer/Descriptors/DescriptorsClassifier.hpp>
 
@@ -18,7 +23,9 @@ namespace faces {
      * and (de)serialization functions for it
      */
     namespace dlibSvm {
-        using KernelType = dlib::histogram_intersection_kernel<dlibResnet::DescriptorType>;
+        /// descriptors of any dimension, so the classifier is not bound to a particular descriptor
+        using SampleType = dlib::matrix<double, 0, 1>;
+        using KernelType = dlib::histogram_intersection_kernel<SampleType>;
         using TrainerType =  dlib::svm_c_trainer<KernelType>;
 
         /**
@@ -39,7 +46,7 @@ namespace faces {
                     : negativeLabel(negativeLabel), positiveLabel(positiveLabel),
                       classifier(classifier) {}
 
-            double classify(dlibResnet::DescriptorType const &descriptor, double threshold = 0.3) {
+            double classify(SampleType const &descriptor, double threshold = 0.3) {
                 double prediction = classifier(descriptor);
                 if (fabs(prediction) < threshold)
                     return -1;
@@ -71,6 +78,92 @@ namespace faces {
                         e.info + "\n while deserializing an object of type MyClassifier");
             }
         }
+
+        /**
+         * All of the pairwise classifiers compiled into a single structure-of-arrays form. @n
+         * Support vectors are shared by many of the pairwise decision functions,
+         * so they are deduplicated and stored only once, which allows to evaluate
+         * the kernel once per unique support vector and then reuse its value in every decision function. @n
+         * The kernel is evaluated in double precision with SIMD, so its sums are in a different order than in dlib;
+         * the decision functions, which land within @ref _exactMargin of the threshold, are evaluated again
+         * in the order of dlib, so the decisions are exactly the same as of the unpacked classifiers
+         */
+        class PackedSvmClassifiers {
+        public:
+            /**
+             * Packs the given classifiers, replacing the current state
+             *
+             * @param classifiers - pairwise classifiers to pack
+             */
+            void compile(std::vector<SingleSvmClassifier> const &classifiers);
+
+            /**
+             * Evaluates all of the pairwise classifiers on the given descriptor and counts their votes
+             *
+             * @param descriptor - face descriptors
+             * @param threshold  - a minimal absolute value of the decision function to vote
+             *
+             * @return a label with the most votes OR -1 if none of the classifiers has voted
+             */
+            [[nodiscard]] int classify(std::vector<double> const &descriptor, double threshold) const;
+
+            /**
+             * Compares the given descriptor with the centroid of support vectors of the given label
+             *
+             * @param descriptor  - face descriptors
+             * @param label       - an expected label
+             * @param maxDistance - a maximal distance to the centroid
+             * @param metric      - a metric of the distance
+             *
+             * @return whether the descriptor is close enough to the label
+             */
+            [[nodiscard]] bool verify(std::vector<double> const &descriptor, int label, double maxDistance,
+                                      Descriptor::Metric metric = Descriptor::Metric::Euclidean) const;
+
+            /**
+             * @return whether there are any compiled classifiers
+             */
+            [[nodiscard]] bool empty() const {
+                return _biases.empty();
+            }
+
+        private:
+            /// a number of doubles processed by a single SIMD instruction
+            static constexpr std::size_t _simdWidth = 4;
+
+            /// a bound of the difference between the SIMD and the sequential sums of a decision function,
+            /// which is orders of magnitude above the rounding errors of the 128-D descriptors
+            static constexpr double _exactMargin = 1e-9;
+
+            /// a dimension of the descriptors
+            std::size_t _dimension = 0;
+            /// a dimension of the descriptors padded to the multiple of @ref _simdWidth
+            std::size_t _stride = 0;
+
+            /// deduplicated support vectors, stored row by row with @ref _stride values per row
+            std::vector<double> _supportVectors;
+
+            /// the i-th classifier uses terms in range [_termOffsets[i], _termOffsets[i + 1])
+            std::vector<std::size_t> _termOffsets;
+            /// an index of the support vector of each term
+            std::vector<std::uint32_t> _termVectors;
+            /// a weight of each term
+            std::vector<double> _termAlphas;
+
+            /// a bias of each classifier
+            std::vector<double> _biases;
+            /// indexes in @ref _labels of the negative and positive label of each classifier
+            std::vector<std::uint32_t> _negativeLabels, _positiveLabels;
+
+            /// sorted unique labels, so ties are resolved in favor of the smallest one
+            std::vector<int> _labels;
+            /// {label: index in @ref _labels}
+            std::unordered_map<int, std::uint32_t> _labelIndexes;
+
+            /// a centroid of the support vectors of each label, with @ref _dimension values per row
+            std::vector<double> _centroids;
+
+        };
     }
 
     /**
@@ -82,13 +175,21 @@ namespace faces {
 
         FACES_MAIN_CONSTRUCTOR(explicit DlibSvmClassifier, Config const &config);
 
-        explicit DlibSvmClassifier(std::string const &classifiersFile);
+        explicit DlibSvmClassifier(std::string const &classifiersFile, double verifyDistance = 0.6,
+                                   Descriptor::Metric verifyMetric = Descriptor::Metric::Euclidean);
+
+        /// a maximal distance to the support vectors centroid of a label to verify it
+        double verifyDistance = 0.6;
+        /// a metric of the @ref verifyDistance, which should be the metric of the classified descriptors
+        Descriptor::Metric verifyMetric = Descriptor::Metric::Euclidean;
 
         void train(std::map<int, std::vector<double>> const &samples) override;
 
     protected:
         int _classifyDescriptors(const std::vector<double> &descriptors) override;
 
+        bool _verify(const std::vector<double> &descriptors, int label) override;
+
         bool _save(std::string const &dst) override;
 
         /**
@@ -103,13 +204,19 @@ namespace faces {
     private:
         std::vector<dlibSvm::SingleSvmClassifier> _classifiers;
 
+        /// @ref _classifiers compiled for the fast classification
+        dlibSvm::PackedSvmClassifiers _packed;
+
     };
 
     FACES_REGISTER_SUBCLASS(DescriptorsClassifier, DlibSvmClassifier, DlibSvm)
 
     FACES_AUGMENT_CONFIG(DlibSvmClassifier,
                          FACES_ADD_CONFIG_OPTION("DlibSvmClassifier.classifiers", "classifiers", "", false,
-                                                 "A path to a model file of Dlib-based SVM OvO face descriptor classifier"))
+                                                 "A path to a model file of Dlib-based SVM OvO face descriptor classifier")
+                                 FACES_ADD_CONFIG_OPTION("DlibSvmClassifier.verifyDistance", "svmVerifyDistance",
+                                                         0.6, false, "A maximal distance to the support vectors "
+                                                                     "centroid of the expected label to verify a face"))
 
 }
 
@@ -0,0 +1,174 @@
+/**
+ * @file GalleryClassifier.cpp
+ * @author Люнгрин Андрей aka prostoichelovek <iam.prostoi.chelovek@gmail.ru>
+ * @date 19 Oct 2026
+ * @copyright MIT License
+ */
+
+#include <fstream>
+
+#include "GalleryClassifier.h"
+
+namespace faces {
+
+    GalleryClassifier::GalleryClassifier(Config const &config) {
+        std::string sharedName;
+        try {
+            sharedName = config["GalleryClassifier.sharedName"].getString();
+        } catch (std::out_of_range &e) {}
+
+        if (!sharedName.empty()) {
+            _attach(sharedName);
+            return;
+        }
+
+        std::string const &galleryFile = config.getDataPath("GalleryClassifier.gallery");
+        _load(galleryFile);
+    }
+
+    GalleryClassifier::GalleryClassifier(std::string const &galleryFile) {
+        _load(galleryFile);
+    }
+
+    std::unique_ptr<GalleryClassifier> GalleryClassifier::fromShared(std::string const &sharedName) {
+        std::unique_ptr<GalleryClassifier> classifier(new GalleryClassifier());
+        classifier->_attach(sharedName);
+        return classifier;
+    }
+
+    void GalleryClassifier::train(std::map<int, std::vector<double>> const &samples) {
+        std::vector<int> labels;
+        std::vector<std::vector<double>> descriptors;
+        for (auto const &sample : samples) {
+            labels.emplace_back(sample.first);
+            descriptors.emplace_back(sample.second);
+        }
+
+        auto gallery = std::make_shared<MappedGallery>();
+        try {
+            _ok = gallery->assign(serializeGallery(labels, descriptors)) && gallery->size() != 0;
+        } catch (std::invalid_argument &e) {
+            spdlog::error("Cannot build a gallery from the given samples: {}", e.what());
+            _ok = false;
+        }
+
+        std::lock_guard lock(_galleryMutex);
+        std::atomic_store(&_gallery, gallery);
+    }
+
+    int GalleryClassifier::_classifyDescriptors(const std::vector<double> &descriptors) {
+        std::shared_ptr<MappedGallery> gallery = _getGallery();
+        if (!gallery || descriptors.size() != gallery->dimension()) {
+            return -1;
+        }
+
+        thread_local std::vector<float> query;
+        query.assign(gallery->stride(), 0.0f);
+        std::copy(descriptors.begin(), descriptors.end(), query.begin());
+
+        std::size_t nearest = 0;
+        float nearestDistance = std::numeric_limits<float>::max();
+        for (std::size_t row = 0; row < gallery->size(); ++row) {
+            float distance = _squaredDistance(*gallery, query.data(), row);
+            if (distance < nearestDistance) {
+                nearestDistance = distance;
+                nearest = row;
+            }
+        }
+
+        double threshold = get_threshold();
+        return nearestDistance > threshold * threshold ? -1 : gallery->label(nearest);
+    }
+
+    bool GalleryClassifier::_verify(const std::vector<double> &descriptors, int label) {
+        std::shared_ptr<MappedGallery> gallery = _getGallery();
+        if (!gallery || descriptors.size() != gallery->dimension()) {
+            return false;
+        }
+
+        thread_local std::vector<float> query;
+        query.assign(gallery->stride(), 0.0f);
+        std::copy(descriptors.begin(), descriptors.end(), query.begin());
+
+        double threshold = get_threshold();
+        auto [first, last] = gallery->findLabel(label);
+        for (std::size_t row = first; row < last; ++row) {
+            if (_squaredDistance(*gallery, query.data(), row) <= threshold * threshold) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool GalleryClassifier::_save(std::string const &dst) {
+        std::shared_ptr<MappedGallery> gallery = _getGallery();
+        if (!gallery) {
+            return false;
+        }
+
+        auto [data, size] = gallery->data();
+        try {
+            std::ofstream file(dst, std::ios::binary);
+            file.exceptions(file.exceptions() | std::ofstream::failbit | std::ofstream::badbit);
+            file.write(data, size);
+        } catch (std::exception &e) {
+            spdlog::error("Cannot save a gallery to {}: {}", dst, e.what());
+            return false;
+        }
+        return true;
+    }
+
+    bool GalleryClassifier::_load(std::string const &galleryFile) {
+        auto gallery = std::make_shared<MappedGallery>();
+        _ok = gallery->open(galleryFile);
+        if (_ok && gallery->size() == 0) {
+            spdlog::error("A gallery was loaded without errors from file {}, however it is empty!", galleryFile);
+            _ok = false;
+        }
+
+        std::lock_guard lock(_galleryMutex);
+        std::atomic_store(&_gallery, gallery);
+        return _ok;
+    }
+
+    bool GalleryClassifier::_attach(std::string const &sharedName) {
+        std::lock_guard lock(_galleryMutex);
+        // the gallery may be published later, so only the control segment is required
+        _ok = _sharedView.attach(sharedName);
+        return _ok;
+    }
+
+    std::shared_ptr<MappedGallery> GalleryClassifier::_getGallery() {
+        if (_sharedView.isAttached()) {
+            std::uint64_t generation = _sharedView.getPublishedGeneration();
+            if (generation != _sharedGeneration.load(std::memory_order_acquire)) {
+                std::lock_guard lock(_galleryMutex);
+                // another thread may have picked it up while this one was waiting
+                if (generation != _sharedGeneration.load(std::memory_order_relaxed)) {
+                    std::atomic_store(&_gallery, _sharedView.refresh());
+                    _sharedGeneration.store(generation, std::memory_order_release);
+                }
+            }
+        }
+
+        std::shared_ptr<MappedGallery> gallery = std::atomic_load(&_gallery);
+
+        if (!gallery || !gallery->isOpen() || !gallery->validate()) {
+            return nullptr;
+        }
+        return gallery;
+    }
+
+    float GalleryClassifier::_squaredDistance(MappedGallery const &gallery, float const *query, std::size_t row) {
+        float const *descriptor = gallery.descriptor(row);
+
+        // the padding of both vectors is zero, so it does not affect the distance
+        float sum = 0;
+        for (std::size_t d = 0; d < gallery.stride(); ++d) {
+            float diff = query[d] - descriptor[d];
+            sum += diff * diff;
+        }
+        return sum;
+    }
+
+}
@@ -0,0 +1,126 @@
+/**
+ * @file GalleryClassifier.h
+ * @author Люнгрин Андрей aka prostoichelovek <iam.prostoi.chelovek@gmail.ru>
+ * @date 19 Oct 2026
+ * @copyright MIT License
+ *
+ * @brief This file contains a nearest neighbour descriptors classifier over a memory-mapped gallery
+ */
+
+#ifndef FACES_GALLERYCLASSIFIER_H
+#define FACES_GALLERYCLASSIFIER_H
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+
+#include <spdlog/spdlog.h>
+
+#include <Config/Config.h>
+#include <Gallery/GalleryFile.h>
+#include <Gallery/SharedGallery.h>
+
+#include <Recognizer/Descriptors/DescriptorsClassifier.hpp>
+
+namespace faces {
+
+    /**
+     * A nearest neighbour descriptors classifier, which memory-maps a gallery file (see GalleryHeader)
+     * and queries it in place, so there is no parse step at startup. @n
+     * The checksum of the gallery is validated on the first classification. @n
+     * If 'GalleryClassifier.sharedName' is set, the gallery is attached read-only from the shared memory
+     * (see SharedGalleryPublisher) instead of the file, and new generations are picked up as they are published
+     */
+    class GalleryClassifier : public DescriptorsClassifier {
+    public:
+        /// a maximal euclidean distance to the nearest gallery descriptor;
+        /// all the predictions above should be treated as unrecognized
+        FACES_OVERRIDE_ATTRIBUTE(threshold, 0.6)
+
+        FACES_MAIN_CONSTRUCTOR(explicit GalleryClassifier, Config const &config);
+
+        explicit GalleryClassifier(std::string const &galleryFile);
+
+        /**
+         * Creates a classifier attached to the shared gallery with the given name
+         *
+         * @param sharedName - a name of the shared gallery, see SharedGalleryPublisher
+         */
+        static std::unique_ptr<GalleryClassifier> fromShared(std::string const &sharedName);
+
+        /**
+         * Replaces the gallery with the given samples; it can be saved with @ref save
+         */
+        void train(std::map<int, std::vector<double>> const &samples) override;
+
+    protected:
+        /// the current gallery; it is replaced as a whole by an atomic store,
+        /// so classification may continue using the old one without locking
+        std::shared_ptr<MappedGallery> _gallery;
+
+        /// a view of the shared gallery, if it is used
+        SharedGalleryView _sharedView;
+        /// the last published generation of the shared gallery, which was picked up
+        std::atomic<std::uint64_t> _sharedGeneration = 0;
+
+        /// serializes the replacements of the gallery
+        std::mutex _galleryMutex;
+
+        GalleryClassifier() = default;
+
+        int _classifyDescriptors(const std::vector<double> &descriptors) override;
+
+        /**
+         * Compares the given descriptor only with the gallery descriptors of the given label,
+         * which are found with the gallery index
+         */
+        bool _verify(const std::vector<double> &descriptors, int label) override;
+
+        /**
+         * Writes the current gallery file to the given destination
+         */
+        bool _save(std::string const &dst) override;
+
+        /**
+         * Memory-maps the gallery from the given file
+         *
+         * @return successfulness of the operation = current _ok
+         */
+        bool _load(std::string const &galleryFile);
+
+        /**
+         * Attaches to the shared gallery with the given name
+         *
+         * @return successfulness of the operation = current _ok
+         */
+        bool _attach(std::string const &sharedName);
+
+        /**
+         * Picks up a new generation of the shared gallery, if it is used and the generation has changed,
+         * and validates the gallery checksum on the first use of each gallery; it locks only to pick up
+         * a new generation
+         *
+         * @return the current gallery OR nullptr if it is not available or corrupted
+         */
+        std::shared_ptr<MappedGallery> _getGallery();
+
+        /**
+         * @return squared euclidean distance between the query and the gallery descriptor at the given row
+         */
+        [[nodiscard]] static float _squaredDistance(MappedGallery const &gallery, float const *query,
+                                                    std::size_t row);
+
+    };
+
+    FACES_REGISTER_SUBCLASS(DescriptorsClassifier, GalleryClassifier, Gallery)
+
+    FACES_AUGMENT_CONFIG(GalleryClassifier,
+                         FACES_ADD_CONFIG_OPTION("GalleryClassifier.gallery", "gallery", "", false,
+                                                 "A path to a binary gallery file of face descriptors")
+                                 FACES_ADD_CONFIG_OPTION("GalleryClassifier.sharedName", "sharedGallery", "", false,
+                                                         "A name of the shared memory gallery to attach to "
+                                                         "instead of the file"))
+
+}
+
+#endif //FACES_GALLERYCLASSIFIER_H
@@ -0,0 +1,129 @@
+/**
+ * @file OcvDnnDescriptor.cpp
+ * @author Люнгрин Андрей aka prostoichelovek <iam.prostoi.chelovek@gmail.ru>
+ * @date 19 Oct 2026
+ * @copyright MIT License
+ */
+
+#include "OcvDnnDescriptor.h"
+
+#include <fstream>
+
+namespace faces {
+
+    OcvDnnDescriptor::OcvDnnDescriptor(Config const &config) {
+        try {
+            _maxBatch = config["OcvDnnDescriptor.maxBatch"].getInt();
+        } catch (std::out_of_range &e) {
+            spdlog::error("Cannot get an option 'OcvDnnDescriptor.maxBatch' from the config!");
+        }
+        _maxBatch = std::max(_maxBatch, 1);
+
+        std::string const &model = config.getModelPath("OcvDnnDescriptor.model");
+        _load(model);
+    }
+
+    OcvDnnDescriptor::OcvDnnDescriptor(std::string const &model, int maxBatch)
+            : _maxBatch(std::max(maxBatch, 1)) {
+        _load(model);
+    }
+
+    std::vector<double> OcvDnnDescriptor::_computeDescriptors(cv::Mat const &faceImg) {
+        std::vector<cv::Mat> imgs{faceImg};
+        cv::Mat embedding = _forward(imgs.cbegin(), imgs.cend());
+
+        std::vector<double> res;
+        embedding.row(0).convertTo(res, CV_64F);
+        return res;
+    }
+
+    std::vector<std::vector<double>> OcvDnnDescriptor::_computeDescriptorsBatch(
+            std::vector<cv::Mat> const &faceImgs) {
+        std::vector<std::vector<double>> res;
+        res.reserve(faceImgs.size());
+
+        for (auto begin = faceImgs.cbegin(); begin != faceImgs.cend();) {
+            auto end = begin + std::min<std::ptrdiff_t>(_maxBatch, faceImgs.cend() - begin);
+
+            cv::Mat embeddings = _forward(begin, end);
+            for (int i = 0; i < embeddings.rows; ++i) {
+                std::vector<double> descriptor;
+                embeddings.row(i).convertTo(descriptor, CV_64F);
+                res.emplace_back(std::move(descriptor));
+            }
+
+            begin = end;
+        }
+
+        return res;
+    }
+
+    Descriptor *OcvDnnDescriptor::clone() const {
+        auto *replica = new OcvDnnDescriptor(*this);
+        if (!replica->_initNet()) {
+            delete replica;
+            return nullptr;
+        }
+        return replica;
+    }
+
+    bool OcvDnnDescriptor::_load(std::string const &model) {
+        _ok = false;
+
+        std::ifstream file(model, std::ios::binary);
+        _modelData = std::make_shared<std::vector<uchar> const>(std::istreambuf_iterator<char>(file),
+                                                                 std::istreambuf_iterator<char>());
+        if (_modelData->empty()) {
+            spdlog::error("Cannot read an ONNX face descriptor from '{}'", model);
+            return _ok;
+        }
+
+        if (!_initNet()) {
+            spdlog::error("Cannot load an ONNX face descriptor from '{}'", model);
+        }
+        return _ok;
+    }
+
+    bool OcvDnnDescriptor::_initNet() {
+        _ok = false;
+        _net = cv::dnn::Net();
+
+        try {
+            _net = cv::dnn::readNetFromONNX(*_modelData);
+            _net.setPreferableBackend(cv::dnn::DNN_BACKEND_OPENCV);
+            _net.setPreferableTarget(cv::dnn::DNN_TARGET_CPU);
+
+            std::vector<cv::Mat> dummy{cv::Mat::zeros(get_faceSize(), CV_8UC3)};
+            cv::Mat embedding = _forward(dummy.cbegin(), dummy.cend());
+            _dimension = embedding.cols;
+        } catch (const cv::Exception &e) {
+            spdlog::error("Cannot create an OpenCV DNN network of the face descriptor: {}", e.err);
+            return _ok;
+        }
+
+        _ok = !_net.empty() && _dimension > 0;
+        return _ok;
+    }
+
+    cv::Mat OcvDnnDescriptor::_forward(std::vector<cv::Mat>::const_iterator begin,
+                                       std::vector<cv::Mat>::const_iterator end) {
+        cv::Mat blob = cv::dnn::blobFromImages(std::vector<cv::Mat>(begin, end), _scaleFactor, get_faceSize(),
+                                               _meanVal, _swapRB, false);
+        _net.setInput(blob);
+        cv::Mat output = _net.forward();
+
+        int batch = static_cast<int>(end - begin);
+        cv::Mat embeddings = output.reshape(1, batch);
+        if (embeddings.type() != CV_32F) {
+            embeddings.convertTo(embeddings, CV_32F);
+        }
+
+        for (int i = 0; i < embeddings.rows; ++i) {
+            cv::Mat row = embeddings.row(i);
+            cv::normalize(row, row);
+        }
+
+        return embeddings;
+    }
+
+}
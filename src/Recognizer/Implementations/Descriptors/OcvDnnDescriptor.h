@@ -0,0 +1,119 @@
+/**
+ * @file OcvDnnDescriptor.h
+ * @author Люнгрин Андрей aka prostoichelovek <iam.prostoi.chelovek@gmail.ru>
+ * @date 19 Oct 2026
+ * @copyright MIT License
+ *
+ * @brief This file contains a descriptor based on an ONNX embedding network run by opencv DNN
+ */
+
+#ifndef FACES_OCVDNNDESCRIPTOR_H
+#define FACES_OCVDNNDESCRIPTOR_H
+
+#include <opencv2/dnn.hpp>
+
+#include <spdlog/spdlog.h>
+
+#include <Config/Config.h>
+
+#include "utils/utils.h"
+#include <Recognizer/Descriptors/Descriptor.hpp>
+
+namespace faces {
+
+    /**
+     * A descriptor based on an ONNX face embedding network (e.g. SFace) run by opencv DNN on the CPU. @n
+     * Both fp32 and int8-quantized models are supported: the precision is defined by the weights of the given model
+     * (e.g. face_recognition_sface_2021dec.onnx or face_recognition_sface_2021dec_int8.onnx),
+     * int8 models require opencv 4.5.4 or newer. @n
+     * The descriptor dimension is taken from the network output, and the descriptors are L2-normalized. @n
+     * SFace expects 112x112 chips aligned to its 5-point template, so the faces should be aligned
+     * with the SfaceAligner; the chips of other aligners (e.g. DlibChipAligner) are resized and lose accuracy
+     *
+     * @see https://github.com/opencv/opencv_zoo/tree/main/models/face_recognition_sface
+     */
+    class OcvDnnDescriptor : public Descriptor {
+    public:
+        FACES_MAIN_CONSTRUCTOR(explicit OcvDnnDescriptor, Config const &config);
+
+        /**
+         * Loads a network from the given ONNX file
+         *
+         * @param model    - a path to the ONNX model
+         * @param maxBatch - a maximal number of images forwarded at once; 1 for the models with a fixed batch size
+         */
+        explicit OcvDnnDescriptor(std::string const &model, int maxBatch = 16);
+
+        /**
+         * Creates a network from the model kept in memory, since copies of cv::dnn::Net share their state
+         */
+        [[nodiscard]] Descriptor *clone() const override;
+
+    protected:
+        /// SFace takes 112x112 aligned chips
+        FACES_OVERRIDE_ATTRIBUTE(faceSize, 112, 112)
+
+        /// SFace matches the faces by the cosine similarity of at least 0.363
+        FACES_OVERRIDE_ATTRIBUTE(metric, Metric::Cosine)
+        FACES_OVERRIDE_ATTRIBUTE(matchDistance, 1 - 0.363)
+
+        /// a blob is created as (img - mean) * scale
+        double _scaleFactor = 1.0;
+        cv::Scalar _meanVal = {0, 0, 0};
+        bool _swapRB = true;
+
+        std::vector<double> _computeDescriptors(cv::Mat const &faceImg) override;
+
+        /**
+         * Forwards the batch through the network in chunks of at most @ref _maxBatch images
+         */
+        std::vector<std::vector<double>> _computeDescriptorsBatch(std::vector<cv::Mat> const &faceImgs) override;
+
+        /**
+         * Reads the given ONNX file and creates a network from it with @ref _initNet
+         *
+         * @param model - a path to the ONNX model
+         *
+         * @return successfulness of the loading = current _ok
+         */
+        bool _load(std::string const &model);
+
+        /**
+         * Creates a network from @ref _modelData and estimates the descriptor dimension with a dummy forward
+         *
+         * @return successfulness of the initialization = current _ok
+         */
+        bool _initNet();
+
+    private:
+        cv::dnn::Net _net;
+
+        /// the content of the ONNX file, shared with the replicas, so they do not read it again
+        std::shared_ptr<std::vector<uchar> const> _modelData;
+
+        int _maxBatch = 16;
+
+        /**
+         * Forwards the given prepared images through the network
+         *
+         * @param begin, end - a range of the images
+         *
+         * @return an N x dimension matrix of the raw embeddings
+         */
+        cv::Mat _forward(std::vector<cv::Mat>::const_iterator begin, std::vector<cv::Mat>::const_iterator end);
+
+    };
+
+    FACES_REGISTER_SUBCLASS(Descriptor, OcvDnnDescriptor, OcvDnn)
+
+    FACES_AUGMENT_CONFIG(OcvDnnDescriptor,
+                         FACES_ADD_CONFIG_OPTION("OcvDnnDescriptor.model", "ocvDescriptorModel", "", false,
+                                                 "A path to an ONNX model (fp32 or int8) of OpenCV DNN-based "
+                                                 "face descriptor")
+                                 FACES_ADD_CONFIG_OPTION("OcvDnnDescriptor.maxBatch", "ocvDescriptorMaxBatch", 16,
+                                                         false, "A maximal number of faces forwarded through "
+                                                                "the OpenCV DNN-based face descriptor at once"))
+
+}
+
+#endif //FACES_OCVDNNDESCRIPTOR_H
@@ -0,0 +1,59 @@
+/**
+ * @file OcvDnnSvmRecognizer.h
+ * @author Люнгрин Андрей aka prostoichelovek <iam.prostoi.chelovek@gmail.ru>
+ * @date 19 Oct 2026
+ * @copyright MIT License
+ *
+ * @brief This file contains a descriptor-based face recognizer with an ONNX embedding network and OvO SVM
+ */
+
+#ifndef FACES_OCVDNNSVMRECOGNIZER_H
+#define FACES_OCVDNNSVMRECOGNIZER_H
+
+#include <Recognizer/Descriptors/DescriptorsRecognizer.h>
+#include <Config/Config.h>
+#include "OcvDnnDescriptor.h"
+#include "DlibSvmClassifier.h"
+
+namespace faces {
+
+    /**
+     * An implementation of the descriptor-based face recognizer,
+     * which uses opencv DNN-based ONNX descriptor and a OvO SVM classifier;
+     * the faces should be aligned with the SfaceAligner
+     */
+    class OcvDnnSvmRecognizer : public DescriptorsRecognizer {
+    public:
+        FACES_MAIN_CONSTRUCTOR(explicit OcvDnnSvmRecognizer, Config const &config) {
+            descriptor = FACES_CREATE_INSTANCE(Descriptor, OcvDnn, config);
+
+            // the classifiers of DlibSvmClassifier are trained on the ResNet descriptors, which SFace does not match
+            double verifyDistance = 1 - 0.363;
+            try {
+                verifyDistance = config["OcvDnnSvmRecognizer.verifyDistance"].getNumber();
+            } catch (std::out_of_range &e) {
+                spdlog::error("Cannot get an option 'OcvDnnSvmRecognizer.verifyDistance' from the config!");
+            }
+            classifier = new DlibSvmClassifier(config.getDataPath("OcvDnnSvmRecognizer.classifiers"),
+                                               verifyDistance, Descriptor::Metric::Cosine);
+
+            _initCache(config);
+            _initReplicas(config);
+            _checkOk();
+        }
+
+    };
+
+    FACES_REGISTER_SUBCLASS(Recognizer, OcvDnnSvmRecognizer, OcvDnnSvm)
+
+    FACES_AUGMENT_CONFIG(OcvDnnSvmRecognizer,
+                         FACES_ADD_CONFIG_OPTION("OcvDnnSvmRecognizer.classifiers", "sfaceClassifiers", "", false,
+                                                 "A path to a model file of SVM OvO classifier of SFace descriptors")
+                                 FACES_ADD_CONFIG_OPTION("OcvDnnSvmRecognizer.verifyDistance",
+                                                         "sfaceVerifyDistance", 0.637, false,
+                                                         "A maximal cosine distance to the support vectors "
+                                                         "centroid of the expected label to verify a face"))
+
+}
+
+#endif //FACES_OCVDNNSVMRECOGNIZER_H
@@ -0,0 +1,100 @@
+/**
+ * @file LostTrackMemory.cpp
+ * @author Люнгрин Андрей aka prostoichelovek <iam.prostoi.chelovek@gmail.ru>
+ * @date 19 Oct 2026
+ * @copyright MIT License
+ */
+
+#include "LostTrackMemory.h"
+
+namespace faces {
+
+    LostTrackMemory::LostTrackMemory(DescriptorsRecognizer *recognizer, Config const &config)
+            : _recognizer(recognizer) {
+        try {
+            _capacity = config["LostTrackMemory.capacity"].getInt();
+            _maxAge = config["LostTrackMemory.maxAge"].getInt();
+            _maxDistance = config["LostTrackMemory.maxDistance"].getNumber();
+            _maxDescriptorDistance = config["LostTrackMemory.maxDescriptorDistance"].getNumber();
+        } catch (std::out_of_range &e) {
+            spdlog::error("Cannot get parameters of the LostTrackMemory from the config, using the default ones");
+        }
+    }
+
+    void LostTrackMemory::watch(TrackManager &tracks) {
+        tracks.onDeath([this, &tracks](TrackInfo const &track) {
+            remember(track, tracks.getFrameIndex());
+        });
+    }
+
+    void LostTrackMemory::remember(TrackInfo const &track, std::size_t frame) {
+        if (_capacity == 0 || track.descriptor.empty()) {
+            return;
+        }
+
+        _expire(frame);
+        if (_entries.size() >= _capacity) {
+            _entries.pop_front();
+        }
+        _entries.push_back({track.id, track.label, track.descriptor, track.rect, frame});
+    }
+
+    std::optional<LostTrackMemory::Entry> LostTrackMemory::take(Face const &face, std::vector<double> &descriptor,
+                                                                std::size_t frame) {
+        _expire(frame);
+        if (_recognizer == nullptr) {
+            return std::nullopt;
+        }
+
+        cv::Point2d center = (face.rect.tl() + face.rect.br()) / 2;
+        std::vector<std::size_t> candidates;
+        for (std::size_t i = 0; i < _entries.size(); ++i) {
+            cv::Rect const &rect = _entries[i].rect;
+            cv::Point2d lostCenter = (rect.tl() + rect.br()) / 2;
+            double size = std::sqrt(std::max(rect.area(), 1));
+            if (cv::norm(center - lostCenter) <= _maxDistance * size) {
+                candidates.emplace_back(i);
+            }
+        }
+        if (candidates.empty()) {
+            return std::nullopt;
+        }
+
+        if (descriptor.empty()) {
+            if (face.img.empty()) {
+                return std::nullopt;
+            }
+            // the recognizer may compute it on the thread of its service, which is the only user of the descriptor
+            descriptor = _recognizer->computeDescriptor(face.img);
+            if (descriptor.empty()) {
+                return std::nullopt;
+            }
+        }
+
+        Descriptor *metric = _recognizer->descriptor;
+        std::size_t best = _entries.size();
+        double bestDistance = _maxDescriptorDistance > 0 ? _maxDescriptorDistance : metric->getMatchDistance();
+        for (std::size_t i : candidates) {
+            double distance = metric->distance(_entries[i].descriptor, descriptor);
+            if (distance <= bestDistance) {
+                best = i;
+                bestDistance = distance;
+            }
+        }
+        if (best == _entries.size()) {
+            return std::nullopt;
+        }
+
+        Entry res = std::move(_entries[best]);
+        _entries.erase(_entries.begin() + best);
+        ++_matchesCount;
+        return res;
+    }
+
+    void LostTrackMemory::_expire(std::size_t frame) {
+        while (!_entries.empty() && frame - _entries.front().lostFrame > _maxAge) {
+            _entries.pop_front();
+        }
+    }
+
+}
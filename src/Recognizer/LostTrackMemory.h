@@ -0,0 +1,133 @@
+/**
+ * @file LostTrackMemory.h
+ * @author Люнгрин Андрей aka prostoichelovek <iam.prostoi.chelovek@gmail.ru>
+ * @date 19 Oct 2026
+ * @copyright MIT License
+ *
+ * @brief This file contains a memory of the recently lost tracks used to re-identify them
+ */
+
+#ifndef FACES_LOSTTRACKMEMORY_H
+#define FACES_LOSTTRACKMEMORY_H
+
+#include <deque>
+#include <optional>
+
+#include <spdlog/spdlog.h>
+
+#include <Config/Config.h>
+#include <Tracker/TrackManager.h>
+#include <Recognizer/Descriptors/DescriptorsRecognizer.h>
+
+namespace faces {
+
+    /**
+     * A bounded memory of the recently lost tracks with their descriptors and labels. @n
+     * A new track is first compared with the tracks lost nearby and not long ago (a spatio-temporal window)
+     * by the distance of the descriptors in the metric of the Descriptor (e.g. the cosine one for SFace),
+     * and it inherits the identity of the closest one,
+     * so it does not need the full recognition. When the memory is full, the oldest track is forgotten
+     */
+    class LostTrackMemory {
+    public:
+        /**
+         * A lost track
+         */
+        struct Entry {
+            TrackId id;
+            int label;
+            std::vector<double> descriptor;
+            /// a bounding box of the face when the track was lost
+            cv::Rect rect;
+            /// TrackManager::getFrameIndex when the track was lost
+            std::size_t lostFrame;
+        };
+
+        /**
+         * @param recognizer - a recognizer to compute descriptors of the new faces with, through its service
+         *                     and cache, in the metric of its descriptor; it is not owned by this class
+         * @param config     - a config with the size of the memory and the matching window
+         */
+        LostTrackMemory(DescriptorsRecognizer *recognizer, Config const &config);
+
+        /**
+         * Remembers the tracks which die in the given manager;
+         * the memory should outlive the manager
+         */
+        void watch(TrackManager &tracks);
+
+        /**
+         * Remembers the given lost track, if it has a descriptor
+         *
+         * @param track - a lost track
+         * @param frame - an index of the frame when the track was lost
+         */
+        void remember(TrackInfo const &track, std::size_t frame);
+
+        /**
+         * Finds the lost track, which the given face continues, and forgets it
+         *
+         * @param face       - a face of a new track
+         * @param descriptor - a descriptor of the face; if it is empty, it is computed only if there are
+         *                     lost tracks in the window, so the caller may keep it for the next attempts
+         * @param frame      - an index of the current frame
+         *
+         * @return the matched lost track OR std::nullopt
+         */
+        std::optional<Entry> take(Face const &face, std::vector<double> &descriptor, std::size_t frame);
+
+        [[nodiscard]] std::size_t size() const {
+            return _entries.size();
+        }
+
+        /**
+         * @return a number of the new tracks which inherited identities of the lost ones
+         */
+        [[nodiscard]] std::size_t getMatchesCount() const {
+            return _matchesCount;
+        }
+
+    private:
+        DescriptorsRecognizer *_recognizer;
+
+        std::size_t _capacity = 32;
+
+        /// a number of frames a lost track is kept
+        std::size_t _maxAge = 50;
+
+        /// a maximal distance between the faces relative to the size of the lost one
+        double _maxDistance = 2.0;
+
+        /// a maximal distance between the descriptors in their metric, 0 means Descriptor::getMatchDistance
+        double _maxDescriptorDistance = 0;
+
+        /// the lost tracks from the oldest to the newest
+        std::deque<Entry> _entries;
+
+        std::size_t _matchesCount = 0;
+
+        /**
+         * Forgets the tracks lost more than @ref _maxAge frames ago
+         */
+        void _expire(std::size_t frame);
+
+    };
+
+    FACES_AUGMENT_CONFIG(LostTrackMemory,
+                         FACES_ADD_CONFIG_OPTION("LostTrackMemory.capacity", "lostTracksCapacity", 32, false,
+                                                 "A maximal number of remembered lost tracks")
+                                 FACES_ADD_CONFIG_OPTION("LostTrackMemory.maxAge", "lostTracksMaxAge", 50, false,
+                                                         "A number of frames a lost track is remembered")
+                                 FACES_ADD_CONFIG_OPTION("LostTrackMemory.maxDistance", "lostTracksMaxDistance",
+                                                         2.0, false, "A maximal distance between a new face and "
+                                                                     "a lost one relative to the face size")
+                                 FACES_ADD_CONFIG_OPTION("LostTrackMemory.maxDescriptorDistance",
+                                                         "lostTracksMaxDescriptorDistance", 0, false,
+                                                         "A maximal distance between descriptors of a new face "
+                                                         "and a lost one in the metric of the descriptor, "
+                                                         "0 means the matching distance of the descriptor")
+    )
+
+}
+
+#endif //FACES_LOSTTRACKMEMORY_H
@@ -0,0 +1,93 @@
+/**
+ * @file RecognitionScheduler.cpp
+ * @author Люнгрин Андрей aka prostoichelovek <iam.prostoi.chelovek@gmail.ru>
+ * @date 19 Oct 2026
+ * @copyright MIT License
+ */
+
+#include "RecognitionScheduler.h"
+
+namespace faces {
+
+    RecognitionScheduler::RecognitionScheduler(Config const &config) {
+        try {
+            _maxFaces = config["RecognitionScheduler.maxFaces"].getInt();
+            _maxTime = std::chrono::duration_cast<Clock::duration>(
+                    std::chrono::duration<double, std::milli>(config["RecognitionScheduler.maxTime"].getNumber()));
+        } catch (std::out_of_range &e) {
+            spdlog::error("Cannot get a budget of the RecognitionScheduler from the config, it is unlimited");
+        }
+    }
+
+    void RecognitionScheduler::rank(std::vector<Candidate> &candidates) {
+        auto group = [](Candidate const &candidate) {
+            return candidate.isNew ? 0 : (candidate.isUnknown ? 1 : 2);
+        };
+
+        std::stable_sort(candidates.begin(), candidates.end(), [&](Candidate const &a, Candidate const &b) {
+            if (group(a) != group(b)) {
+                return group(a) < group(b);
+            }
+            if (a.size != b.size) {
+                return a.size > b.size;
+            }
+            return a.staleness > b.staleness;
+        });
+    }
+
+    void RecognitionScheduler::beginFrame(Clock::time_point deadline) {
+        _frameStart = Clock::now();
+        _frameDeadline = deadline;
+        _frameFaces = 0;
+    }
+
+    bool RecognitionScheduler::hasBudget(std::size_t pending) const {
+        std::size_t faces = static_cast<std::size_t>(_frameFaces) + pending;
+        if (_maxFaces > 0 && faces >= static_cast<std::size_t>(_maxFaces)) {
+            return false;
+        }
+
+        auto predictedEnd = Clock::now() + std::chrono::duration_cast<Clock::duration>(
+                std::chrono::duration<double>(_averageCost * static_cast<double>(pending + 1)));
+        // the deadline of the frame is hard, unlike the time budget
+        if (_frameDeadline != Clock::time_point::max() && predictedEnd > _frameDeadline) {
+            return false;
+        }
+        if (_maxTime != Clock::duration::zero()) {
+            // at least one face is recognized on each frame, so the queue keeps moving
+            return faces == 0 || predictedEnd - _frameStart <= _maxTime;
+        }
+        return true;
+    }
+
+    void RecognitionScheduler::recordRecognition(Clock::duration duration) {
+        double cost = std::chrono::duration<double>(duration).count();
+        _averageCost = _averageCost == 0 ? cost : 0.9 * _averageCost + 0.1 * cost;
+        ++_frameFaces;
+    }
+
+    void RecognitionScheduler::endFrame(std::size_t deferred) {
+        double latency = std::chrono::duration<double, std::milli>(Clock::now() - _frameStart).count();
+        if (_latencies.size() < _latencyWindow) {
+            _latencies.emplace_back(latency);
+        } else {
+            _latencies[_nextLatency] = latency;
+        }
+        _nextLatency = (_nextLatency + 1) % _latencyWindow;
+
+        _deferredCount += deferred;
+    }
+
+    double RecognitionScheduler::getLatencyPercentile(double percentile) const {
+        if (_latencies.empty()) {
+            return 0;
+        }
+
+        std::vector<double> latencies = _latencies;
+        auto nth = latencies.begin() + static_cast<std::size_t>(std::clamp(percentile, 0.0, 1.0)
+                                                                * (latencies.size() - 1));
+        std::nth_element(latencies.begin(), nth, latencies.end());
+        return *nth;
+    }
+
+}
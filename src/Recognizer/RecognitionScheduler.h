@@ -0,0 +1,134 @@
+/**
+ * @file RecognitionScheduler.h
+ * @author Люнгрин Андрей aka prostoichelovek <iam.prostoi.chelovek@gmail.ru>
+ * @date 19 Oct 2026
+ * @copyright MIT License
+ *
+ * @brief This file contains a scheduler, which limits the recognition cost of a frame
+ */
+
+#ifndef FACES_RECOGNITIONSCHEDULER_H
+#define FACES_RECOGNITIONSCHEDULER_H
+
+#include <chrono>
+#include <vector>
+
+#include <spdlog/spdlog.h>
+
+#include <Config/Config.h>
+
+namespace faces {
+
+    /**
+     * A scheduler, which ranks faces waiting for recognition and limits a number of faces
+     * and time spent on recognition per frame; faces out of the budget are deferred to the next frames. @n
+     * The budget of a frame may also be limited by its deadline (e.g. given by the Pipeline),
+     * so the recognition uses only the slack left by the other stages. @n
+     * Faces are ranked in the following order: new tracks, unrecognized tracks, and then the tracks
+     * which are due for a refresh; inside each group larger and better faces come first,
+     * and then the ones which were not recognized for the longest time
+     */
+    class RecognitionScheduler {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        /**
+         * A face waiting for recognition
+         */
+        struct Candidate {
+            /// an index of the face on the frame
+            std::size_t index;
+            /// whether the track of the face was never recognized
+            bool isNew;
+            /// whether the track of the face has an unknown label
+            bool isUnknown;
+            /// a size of the face multiplied by its quality score
+            double size;
+            /// frames passed since the last recognition of the track
+            int staleness;
+        };
+
+        explicit RecognitionScheduler(Config const &config);
+
+        /**
+         * Sorts the candidates by their priority
+         *
+         * @param candidates - faces waiting for recognition
+         */
+        static void rank(std::vector<Candidate> &candidates);
+
+        /**
+         * Starts the budget of a new frame
+         *
+         * @param deadline - a time by which the recognition of the frame should be finished
+         */
+        void beginFrame(Clock::time_point deadline = Clock::time_point::max());
+
+        /**
+         * @param pending - a number of faces already scheduled on the current frame, but not recognized yet
+         *
+         * @return whether one more face fits into the budget of the current frame,
+         *         predicting its cost and the cost of the pending ones from the previous recognitions
+         */
+        [[nodiscard]] bool hasBudget(std::size_t pending = 0) const;
+
+        /**
+         * Records a cost of a single recognition
+         *
+         * @param duration - time spent on the recognition
+         */
+        void recordRecognition(Clock::duration duration);
+
+        /**
+         * Finishes the current frame, recording its latency
+         *
+         * @param deferred - a number of faces deferred to the next frames
+         */
+        void endFrame(std::size_t deferred);
+
+        /**
+         * @param percentile - a percentile in range [0, 1] (e.g. 0.99)
+         *
+         * @return a percentile of the recognition latency of the recent frames in milliseconds
+         */
+        [[nodiscard]] double getLatencyPercentile(double percentile) const;
+
+        /**
+         * @return a total number of faces deferred to the next frames
+         */
+        [[nodiscard]] std::size_t getDeferredCount() const {
+            return _deferredCount;
+        }
+
+    protected:
+        /// a maximal number of faces recognized per frame, 0 means unlimited
+        int _maxFaces = 0;
+        /// a maximal time spent on recognition per frame, 0 means unlimited
+        Clock::duration _maxTime = Clock::duration::zero();
+
+        /// a number of the recent frames kept to compute latency percentiles
+        static constexpr std::size_t _latencyWindow = 1024;
+        std::vector<double> _latencies;
+        std::size_t _nextLatency = 0;
+
+        Clock::time_point _frameStart;
+        Clock::time_point _frameDeadline = Clock::time_point::max();
+        int _frameFaces = 0;
+        /// an exponential moving average of a single recognition cost
+        double _averageCost = 0;
+
+        std::size_t _deferredCount = 0;
+
+    };
+
+    FACES_AUGMENT_CONFIG(RecognitionScheduler,
+                         FACES_ADD_CONFIG_OPTION("RecognitionScheduler.maxFaces", "maxRecognizedFaces", 0, false,
+                                                 "A maximal number of faces recognized per frame, 0 is unlimited")
+                                 FACES_ADD_CONFIG_OPTION("RecognitionScheduler.maxTime", "maxRecognitionTime", 0,
+                                                         false, "A maximal time in milliseconds spent on "
+                                                                "recognition per frame, 0 is unlimited")
+    )
+
+}
+
+#endif //FACES_RECOGNITIONSCHEDULER_H
@@ -11,6 +11,7 @@
 #define FACES_RECOGNIZER_HPP
 
 #include "Face/Face.h"
+#include "utils/Async.hpp"
 
 namespace faces {
 
@@ -22,6 +23,7 @@ namespace faces {
         /**
          * Estimate a label of the given face image.
          * This is a wrapper around the actual recognition method, which is just checking the @ref _ok flag
+         * and skips faces which are not acceptable by their quality
          *
          * @param face - the face, estimate a label for img of which
          */
@@ -30,21 +32,93 @@ namespace faces {
                 return;
             }
 
-            if (face.img.empty()) return;
-            face.label = _recognize(face.img);
+            if (face.img.empty() || !face.quality.acceptable) return;
+            face.label = _recognizeFace(face, -1);
         }
 
         /**
-         * A helper method which recognizes a bunch of faces
+         * Estimate a label of the given face image, which is expected to have the given label
+         * (e.g. a label of its track), so the recognizer may only verify it instead of the full search
+         *
+         * @param face          - the face, estimate a label for img of which
+         * @param expectedLabel - a tentative label of the face OR -1 if it is unknown
+         */
+        void recognize(Face &face, int expectedLabel) {
+            if (!_ok) {
+                return;
+            }
+
+            if (face.img.empty() || !face.quality.acceptable) return;
+            face.label = _recognizeFace(face, expectedLabel);
+        }
+
+        /**
+         * Recognizes the given faces together, verifying their expected labels, with @ref _recognizeFaces,
+         * so the recognizer may process them at once (e.g. queue all of them into a DescriptorService
+         * before waiting for any); the faces without images or not acceptable by their quality are skipped
+         *
+         * @param faces          - the faces to recognize
+         * @param expectedLabels - a tentative label of each of the faces OR -1 if it is unknown
+         */
+        void recognize(std::vector<Face *> const &faces, std::vector<int> const &expectedLabels) {
+            if (!_ok) {
+                return;
+            }
+
+            std::vector<Face *> toRecognize;
+            std::vector<int> labels;
+            for (std::size_t i = 0; i < faces.size(); ++i) {
+                if (faces[i]->img.empty() || !faces[i]->quality.acceptable) continue;
+                toRecognize.emplace_back(faces[i]);
+                labels.emplace_back(i < expectedLabels.size() ? expectedLabels[i] : -1);
+            }
+
+            labels = _recognizeFaces(toRecognize, labels);
+            for (std::size_t i = 0; i < toRecognize.size(); ++i) {
+                toRecognize[i]->label = labels[i];
+            }
+        }
+
+        /**
+         * Recognizes a bunch of faces at once with @ref _recognizeBatch,
+         * so the recognizer may process them in parallel; labels are assigned in the order of the faces
          *
          * @param faces - faces, estimate a label for img of which
          */
         void recognize(std::vector<Face> &faces) {
+            if (!_ok) {
+                return;
+            }
+
+            std::vector<Face *> toRecognize;
+            std::vector<cv::Mat> imgs;
             for (auto &face : faces) {
-                recognize(face);
+                if (face.img.empty() || !face.quality.acceptable) continue;
+                toRecognize.emplace_back(&face);
+                imgs.emplace_back(face.img);
+            }
+
+            std::vector<int> labels = _recognizeBatch(imgs);
+            for (std::size_t i = 0; i < toRecognize.size(); ++i) {
+                toRecognize[i]->label = labels[i];
             }
         }
 
+        /**
+         * Recognizes the given faces with @ref recognize(std::vector<Face> &) on the ThreadPool;
+         * the asynchronous calls of a recognizer run one at a time in the order of the calls
+         *
+         * @param faces - faces, estimate a label for img of which
+         *
+         * @return a future of the faces with their labels
+         */
+        Future<std::vector<Face>> recognizeAsync(std::vector<Face> faces) {
+            return _strand.run([this, faces]() mutable {
+                recognize(faces);
+                return std::move(faces);
+            });
+        }
+
         /**
          * Train a detector
          *
@@ -63,6 +137,9 @@ namespace faces {
         /// the flag which indicates the readiness of the recognizer
         bool _ok = false;
 
+        /// runs the asynchronous calls one at a time
+        Strand _strand;
+
         /**
          * Estimate a label of the given face image
          *
@@ -72,6 +149,66 @@ namespace faces {
          */
         virtual int _recognize(cv::Mat const &img) = 0;
 
+        /**
+         * Estimate labels of the given face images;
+         * the default implementation recognizes them one by one, you may override it to process them in parallel
+         *
+         * @param imgs - face ROIs
+         *
+         * @returns a label for each of the faces, in the same order
+         */
+        virtual std::vector<int> _recognizeBatch(std::vector<cv::Mat> const &imgs) {
+            std::vector<int> res;
+            for (cv::Mat const &img : imgs) {
+                res.emplace_back(_recognize(img));
+            }
+            return res;
+        }
+
+        /**
+         * Verify that the given face image has the expected label, recognizing it if not;
+         * the default implementation just recognizes the image
+         *
+         * @param img           - face ROI
+         * @param expectedLabel - a tentative label of the face
+         *
+         * @returns a label of the face
+         */
+        virtual int _verifyOrRecognize(cv::Mat const &img, int expectedLabel) {
+            return _recognize(img);
+        }
+
+        /**
+         * Estimate a label of the given face, which may use and fill other its fields (e.g. Face::descriptor);
+         * the default implementation recognizes or verifies its image
+         *
+         * @param face          - the face to recognize
+         * @param expectedLabel - a tentative label of the face OR -1 if it is unknown
+         *
+         * @returns a label of the face
+         */
+        virtual int _recognizeFace(Face &face, int expectedLabel) {
+            return expectedLabel < 0 ? _recognize(face.img) : _verifyOrRecognize(face.img, expectedLabel);
+        }
+
+        /**
+         * Estimate labels of the given faces, which may use and fill other their fields;
+         * the default implementation recognizes them one by one with @ref _recognizeFace
+         *
+         * @param faces          - the faces to recognize
+         * @param expectedLabels - a tentative label of each of the faces OR -1 if it is unknown
+         *
+         * @returns a label for each of the faces, in the same order
+         */
+        virtual std::vector<int> _recognizeFaces(std::vector<Face *> const &faces,
+                                                 std::vector<int> const &expectedLabels) {
+            std::vector<int> res;
+            for (std::size_t i = 0; i < faces.size(); ++i) {
+                res.emplace_back(_recognizeFace(*faces[i], expectedLabels[i]));
+            }
+            return res;
+        }
+
     };
 
 }
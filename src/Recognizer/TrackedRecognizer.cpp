@@ -0,0 +1,220 @@
+/**
+ * @file TrackedRecognizer.cpp
+ * @author Люнгрин Андрей aka prostoichelovek <iam.prostoi.chelovek@gmail.ru>
+ * @date 19 Oct 2026
+ * @copyright MIT License
+ */
+
+#include "TrackedRecognizer.h"
+
+namespace faces {
+
+    TrackedRecognizer::TrackedRecognizer(Recognizer *recognizer, Config const &config)
+            : _recognizer(recognizer), _scheduler(config) {
+        try {
+            _refreshInterval = config["TrackedRecognizer.refreshInterval"].getInt();
+            _uncertainRefreshInterval = config["TrackedRecognizer.uncertainRefreshInterval"].getInt();
+            _qualityGain = config["TrackedRecognizer.qualityGain"].getNumber();
+            _votesWindow = config["TrackedRecognizer.votesWindow"].getInt();
+            _minVoteShare = config["TrackedRecognizer.minVoteShare"].getNumber();
+        } catch (std::out_of_range &e) {
+            spdlog::error("Cannot get a refresh policy of the TrackedRecognizer from the config, "
+                          "using the default one");
+        }
+    }
+
+    void TrackedRecognizer::recognize(std::vector<Face> &faces, std::vector<std::pair<int, int>> const &matches) {
+        std::vector<TrackState> states(faces.size());
+        for (auto const &[prevIdx, actualIdx] : matches) {
+            if (prevIdx >= 0 && actualIdx >= 0
+                && prevIdx < static_cast<int>(_states.size()) && actualIdx < static_cast<int>(faces.size())) {
+                states[actualIdx] = std::move(_states[prevIdx]);
+            }
+        }
+
+        std::vector<TrackState *> statePtrs;
+        for (TrackState &state : states) {
+            statePtrs.emplace_back(&state);
+        }
+        _recognize(faces, statePtrs, RecognitionScheduler::Clock::time_point::max());
+
+        _states = std::move(states);
+    }
+
+    void TrackedRecognizer::recognize(std::vector<Face> &faces, TrackManager &tracks,
+                                      RecognitionScheduler::Clock::time_point deadline) {
+        // faces without tracks are recognized as new ones every time
+        std::vector<TrackState> untracked(faces.size());
+
+        std::vector<TrackState *> states;
+        for (std::size_t i = 0; i < faces.size(); ++i) {
+            TrackId id = faces[i].trackId;
+            TrackState *state = tracks.getAttachment<TrackState>(id, _attachmentKey);
+            if (state == nullptr && tracks.attach(id, _attachmentKey, TrackState())) {
+                state = tracks.getAttachment<TrackState>(id, _attachmentKey);
+            }
+            states.emplace_back(state != nullptr ? state : &untracked[i]);
+        }
+
+        _recognize(faces, states, deadline, &tracks);
+
+        for (Face const &face : faces) {
+            if (TrackInfo *track = tracks.get(face.trackId)) {
+                track->label = face.label;
+                if (!face.descriptor.empty()) {
+                    track->descriptor = face.descriptor;
+                }
+            }
+        }
+    }
+
+    void TrackedRecognizer::_recognize(std::vector<Face> &faces, std::vector<TrackState *> const &states,
+                                       RecognitionScheduler::Clock::time_point deadline, TrackManager *tracks) {
+        std::vector<RecognitionScheduler::Candidate> candidates;
+        for (std::size_t i = 0; i < faces.size(); ++i) {
+            Face const &face = faces[i];
+            TrackState const &state = *states[i];
+            // faces propagated by a tracker have no images
+            if (face.img.empty() || !face.quality.acceptable) continue;
+
+            if (_needsRecognition(state, face)) {
+                double score = face.quality.score >= 0 ? face.quality.score : 1.0;
+                candidates.push_back({i, !state.recognized, state.label == -1,
+                                      face.rect.area() * score, state.framesSinceRecognition});
+            } else {
+                // only the faces, which could be recognized, but did not need it, saved a recognition
+                ++_reusedCount;
+            }
+        }
+        RecognitionScheduler::rank(candidates);
+
+        std::vector<bool> isRecognized(faces.size(), false);
+        std::vector<std::size_t> batch;
+        std::vector<Face *> batchFaces;
+        std::vector<int> expectedLabels;
+        std::size_t scheduled = 0;
+        _scheduler.beginFrame(deadline);
+        for (; scheduled < candidates.size() && _scheduler.hasBudget(batch.size()); ++scheduled) {
+            std::size_t idx = candidates[scheduled].index;
+            TrackState &state = *states[idx];
+            isRecognized[idx] = true;
+
+            auto start = RecognitionScheduler::Clock::now();
+            // the matching with the lost tracks computes a descriptor, so it takes a place in the budget too
+            if (tracks != nullptr && _lostTracks != nullptr && !state.recognized
+                && _reidentify(state, faces[idx], *tracks)) {
+                ++_reidentifiedCount;
+                _scheduler.recordRecognition(RecognitionScheduler::Clock::now() - start);
+                continue;
+            }
+
+            // a label of a known track is only verified, unless it does not match anymore
+            batch.emplace_back(idx);
+            batchFaces.emplace_back(&faces[idx]);
+            expectedLabels.emplace_back(state.label);
+        }
+
+        if (!batch.empty()) {
+            // the faces are recognized together, so the recognizer may compute their descriptors in one batch
+            auto start = RecognitionScheduler::Clock::now();
+            _recognizer->recognize(batchFaces, expectedLabels);
+            auto cost = (RecognitionScheduler::Clock::now() - start) / static_cast<int>(batch.size());
+            for (std::size_t idx : batch) {
+                _vote(*states[idx], faces[idx]);
+                _scheduler.recordRecognition(cost);
+                ++_recognitionsCount;
+            }
+        }
+        _scheduler.endFrame(candidates.size() - scheduled);
+
+        for (std::size_t i = 0; i < faces.size(); ++i) {
+            if (!isRecognized[i]) {
+                ++states[i]->framesSinceRecognition;
+            }
+            faces[i].label = states[i]->label;
+        }
+    }
+
+    bool TrackedRecognizer::_reidentify(TrackState &state, Face &face, TrackManager &tracks) {
+        TrackInfo *track = tracks.get(face.trackId);
+        if (track == nullptr || face.img.empty() || !face.quality.acceptable) {
+            return false;
+        }
+
+        // the descriptor is kept on the track, so it is computed once for all of the attempts
+        if (track->descriptor.empty()) {
+            track->descriptor = face.descriptor;
+        }
+        std::optional<LostTrackMemory::Entry> lost = _lostTracks->take(face, track->descriptor,
+                                                                        tracks.getFrameIndex());
+        // the recognition of the face on this frame does not compute it again
+        if (face.descriptor.empty()) {
+            face.descriptor = track->descriptor;
+        }
+        if (!lost) {
+            return false;
+        }
+
+        // the lost track counts as a single recognition, so its label is verified on the next refresh
+        state.votes = {lost->label};
+        state.label = lost->label;
+        state.confidence = lost->label >= 0 ? 1 : 0;
+        state.framesSinceRecognition = 0;
+        state.quality = _getQuality(face);
+        state.recognized = true;
+
+        track->previousId = lost->id;
+        return true;
+    }
+
+    bool TrackedRecognizer::_needsRecognition(TrackState const &state, Face const &face) const {
+        if (!state.recognized) {
+            return true;
+        }
+
+        int const nextFrame = state.framesSinceRecognition + 1;
+        if (nextFrame >= _refreshInterval) {
+            return true;
+        }
+
+        bool uncertain = state.label == -1 || state.confidence < _minVoteShare;
+        if (uncertain && nextFrame >= _uncertainRefreshInterval) {
+            return true;
+        }
+
+        // the improvement cannot be told without the quality scores
+        double quality = _getQuality(face);
+        if (quality < 0 || state.quality < 0) {
+            return false;
+        }
+        return quality > state.quality * _qualityGain;
+    }
+
+    void TrackedRecognizer::_vote(TrackState &state, Face const &face) const {
+        state.votes.emplace_back(face.label);
+        while (state.votes.size() > std::max<std::size_t>(_votesWindow, 1)) {
+            state.votes.pop_front();
+        }
+
+        std::map<int, int> counts;
+        for (int label : state.votes) {
+            if (label >= 0) {
+                counts[label]++;
+            }
+        }
+
+        auto best = std::max_element(counts.begin(), counts.end(),
+                                     [](auto const &a, auto const &b) { return a.second < b.second; });
+        state.label = best == counts.end() ? -1 : best->first;
+        state.confidence = best == counts.end() ? 0 : static_cast<double>(best->second) / state.votes.size();
+
+        state.framesSinceRecognition = 0;
+        state.quality = _getQuality(face);
+        state.recognized = true;
+    }
+
+    double TrackedRecognizer::_getQuality(Face const &face) {
+        return face.quality.score >= 0 ? face.quality.score : -1;
+    }
+
+}
@@ -0,0 +1,216 @@
+/**
+ * @file TrackedRecognizer.h
+ * @author Люнгрин Андрей aka prostoichelovek <iam.prostoi.chelovek@gmail.ru>
+ * @date 19 Oct 2026
+ * @copyright MIT License
+ *
+ * @brief This file contains a track-aware wrapper around face recognizers
+ */
+
+#ifndef FACES_TRACKEDRECOGNIZER_H
+#define FACES_TRACKEDRECOGNIZER_H
+
+#include <deque>
+
+#include <spdlog/spdlog.h>
+
+#include <Config/Config.h>
+
+#include <Tracker/TrackManager.h>
+
+#include "Recognizer.hpp"
+#include "RecognitionScheduler.h"
+#include "LostTrackMemory.h"
+
+namespace faces {
+
+    /**
+     * A track-aware wrapper around a Recognizer, which recognizes a face once when its track appears
+     * and reuses the label on the following frames. @n
+     * A track is recognized again only when:
+     *  - it was not recognized for `refreshInterval` frames;
+     *  - its label is unknown or the votes do not agree, and it was not recognized for `uncertainRefreshInterval`;
+     *  - the face became better than at the last recognition by `qualityGain` times,
+     *    if the quality of both of the faces was estimated.
+     *
+     * The label of a track is a majority vote of its last `votesWindow` recognitions.
+     * Faces which are not acceptable by their quality (see QualityEstimator) are never recognized. @n
+     * The per-frame recognition budget is enforced by a RecognitionScheduler,
+     * so the tracks which did not fit into it are recognized on the next frames. @n
+     * If a LostTrackMemory is set, a new track is first matched with the recently lost ones
+     * and inherits the label of the matched track without the recognition; the matching computes a descriptor,
+     * so it is charged to the budget of the scheduler, and the descriptor is kept on the track (TrackInfo::descriptor)
+     * and reused by the recognition
+     */
+    class TrackedRecognizer {
+    public:
+        /**
+         * @param recognizer - a recognizer to use; it is not owned by this class
+         * @param config     - a config with the refresh policy
+         */
+        TrackedRecognizer(Recognizer *recognizer, Config const &config);
+
+        /**
+         * Recognizes the faces whose tracks need it and assigns labels of their tracks to all of the faces
+         *
+         * @param faces   - faces on the current frame
+         * @param matches - matches of the previous faces to the current ones returned by Tracker::track
+         */
+        void recognize(std::vector<Face> &faces, std::vector<std::pair<int, int>> const &matches);
+
+        /**
+         * Recognizes the faces whose tracks need it and assigns labels of their tracks to all of the faces;
+         * the recognition state is attached to the tracks, and their labels are updated
+         *
+         * @param faces    - faces on the current frame with their Face::trackId set by the TrackManager
+         * @param tracks   - the manager of the tracks of the faces
+         * @param deadline - a time by which the recognition of the frame should be finished;
+         *                   the tracks, which do not fit before it, are deferred to the next frames
+         */
+        void recognize(std::vector<Face> &faces, TrackManager &tracks,
+                       RecognitionScheduler::Clock::time_point deadline
+                       = RecognitionScheduler::Clock::time_point::max());
+
+        /**
+         * Sets a memory of the lost tracks to re-identify the new tracks with;
+         * it is used only with a TrackManager
+         *
+         * @param memory - a memory of the lost tracks OR nullptr; it is not owned by this class
+         */
+        void setLostTrackMemory(LostTrackMemory *memory) {
+            _lostTracks = memory;
+        }
+
+        /**
+         * @return a number of actual recognitions performed
+         */
+        [[nodiscard]] std::size_t getRecognitionsCount() const {
+            return _recognitionsCount;
+        }
+
+        /**
+         * @return a number of faces, which could be recognized, but reused a label of their track,
+         *         since it did not need a recognition; the faces without images, the rejected by their quality
+         *         and the deferred by the scheduler (see RecognitionScheduler::getDeferredCount) are not counted
+         */
+        [[nodiscard]] std::size_t getReusedCount() const {
+            return _reusedCount;
+        }
+
+        /**
+         * @return a number of the new tracks, which inherited labels of the lost ones
+         */
+        [[nodiscard]] std::size_t getReidentifiedCount() const {
+            return _reidentifiedCount;
+        }
+
+        /**
+         * @return the scheduler of recognitions, which keeps the latency statistics
+         */
+        [[nodiscard]] RecognitionScheduler const &getScheduler() const {
+            return _scheduler;
+        }
+
+        [[nodiscard]] bool isOk() const {
+            return _recognizer != nullptr && _recognizer->isOk();
+        }
+
+    protected:
+        /**
+         * A recognition state of a single track
+         */
+        struct TrackState {
+            /// an aggregated label of the track
+            int label = -1;
+            /// a share of the votes for the @ref label
+            double confidence = 0;
+            /// labels of the last recognitions
+            std::deque<int> votes;
+            /// frames passed since the last recognition
+            int framesSinceRecognition = 0;
+            /// quality of the face at the last recognition OR -1 if it was not estimated
+            double quality = -1;
+            /// whether the track was recognized at least once
+            bool recognized = false;
+        };
+
+        Recognizer *_recognizer;
+
+        RecognitionScheduler _scheduler;
+
+        LostTrackMemory *_lostTracks = nullptr;
+
+        int _refreshInterval = 30;
+        int _uncertainRefreshInterval = 5;
+        double _qualityGain = 1.5;
+        std::size_t _votesWindow = 7;
+        double _minVoteShare = 0.6;
+
+        /// states of the tracks of the faces on the previous frame
+        std::vector<TrackState> _states;
+
+        std::size_t _recognitionsCount = 0;
+        std::size_t _reusedCount = 0;
+        std::size_t _reidentifiedCount = 0;
+
+        /// a key of the recognition state in the attachments of a track
+        static constexpr char const *_attachmentKey = "TrackedRecognizer";
+
+        /**
+         * Recognizes the faces with the given states of their tracks
+         *
+         * @param faces    - faces on the current frame
+         * @param states   - a state of the track of each face
+         * @param deadline - a time by which the recognition should be finished
+         * @param tracks   - the manager of the tracks of the faces to re-identify the new ones with OR nullptr
+         */
+        void _recognize(std::vector<Face> &faces, std::vector<TrackState *> const &states,
+                        RecognitionScheduler::Clock::time_point deadline, TrackManager *tracks = nullptr);
+
+        /**
+         * Tries to match the face of a new track with the lost tracks
+         * and seeds the state of the track with the label of the matched one
+         *
+         * @return whether the face was matched
+         */
+        bool _reidentify(TrackState &state, Face &face, TrackManager &tracks);
+
+        /**
+         * @return whether the track of the given face should be recognized on this frame
+         */
+        [[nodiscard]] bool _needsRecognition(TrackState const &state, Face const &face) const;
+
+        /**
+         * Adds the label of the just recognized face to the votes of its track
+         */
+        void _vote(TrackState &state, Face const &face) const;
+
+        /**
+         * @return a quality measure of the face in [0, 1] used to decide whether it improved
+         *         OR -1 if it was not estimated
+         */
+        [[nodiscard]] static double _getQuality(Face const &face);
+
+    };
+
+    FACES_AUGMENT_CONFIG(TrackedRecognizer,
+                         FACES_ADD_CONFIG_OPTION("TrackedRecognizer.refreshInterval", "refreshInterval", 30,
+                                                 false, "A number of frames after which a track is recognized again")
+                                 FACES_ADD_CONFIG_OPTION("TrackedRecognizer.uncertainRefreshInterval",
+                                                         "uncertainRefreshInterval", 5, false,
+                                                         "A number of frames after which an unknown "
+                                                         "or uncertain track is recognized again")
+                                 FACES_ADD_CONFIG_OPTION("TrackedRecognizer.qualityGain", "qualityGain", 1.5,
+                                                         false, "How many times better a face should become "
+                                                                "to recognize its track again")
+                                 FACES_ADD_CONFIG_OPTION("TrackedRecognizer.votesWindow", "votesWindow", 7,
+                                                         false, "A number of the last recognitions of a track "
+                                                                "to aggregate its label from")
+                                 FACES_ADD_CONFIG_OPTION("TrackedRecognizer.minVoteShare", "minVoteShare", 0.6,
+                                                         false, "A minimal share of votes for a label of a track "
+                                                                "to treat it as certain")
+    )
+
+}
+
+#endif //FACES_TRACKEDRECOGNIZER_H
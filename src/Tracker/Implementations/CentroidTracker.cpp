@@ -27,60 +27,117 @@ namespace faces {
                                                              cv::Mat const &prevImg,
                                                              cv::Mat const &actualImg) {
         std::vector<std::pair<int, int>> res;
-        std::map<std::size_t, std::pair<std::size_t, double>> candidates;
-
-        std::vector<cv::Point> prevCentroids = _getCentroids(prevFaces);
-        std::vector<cv::Point> actualCentroids = _getCentroids(actualFaces);
-
-        for (std::size_t i = 0; i < prevCentroids.size(); ++i) {
-            std::vector<double> distances;
-            std::transform(actualCentroids.begin(), actualCentroids.end(), std::back_inserter(distances),
-                           [&](cv::Point &pt) -> double { return getDist(prevCentroids[i], pt); });
-
-            auto minDistance = std::min_element(distances.begin(), distances.end());
-            if (!distances.empty()) {
-                int idx = std::distance(distances.begin(), minDistance);
-
-                decltype(candidates)::iterator candidateItr;
-                bool isFoundAndGreater = (candidateItr = candidates.find(idx)) != candidates.end()
-                                         && *minDistance < candidateItr->second.second;
-                if (*minDistance < _maxDistance && (isFoundAndGreater || candidateItr == candidates.end())) {
-                    auto &candidate = candidates[idx];
-                    candidate.first = i;
-                    candidate.second = *minDistance;
-                }
+
+        _getCentroids(prevFaces, _prevCentroids);
+        _getCentroids(actualFaces, _actualCentroids);
+
+        std::size_t const actualCount = _actualCentroids.size();
+        _claims.assign(actualCount, -1);
+        _claimDistances.assign(actualCount, 0);
+        _isPrevMatched.assign(_prevCentroids.size(), false);
+
+        if (actualCount != 0 && _maxDistance > 0) {
+            // Grid ->
+            cv::Point minPt = _actualCentroids.front(), maxPt = minPt;
+            for (cv::Point const &pt : _actualCentroids) {
+                minPt.x = std::min(minPt.x, pt.x);
+                minPt.y = std::min(minPt.y, pt.y);
+                maxPt.x = std::max(maxPt.x, pt.x);
+                maxPt.y = std::max(maxPt.y, pt.y);
             }
-        }
 
-        for (auto const &candidate : candidates) {
-            std::size_t const &actualIdx = candidate.first;
-            std::size_t const &prevIdx = candidate.second.first;
-            res.emplace_back(prevIdx, actualIdx);
+            // cells should not be smaller than the max distance, so the matches are only in the neighbouring ones;
+            // they are enlarged for sparse faces, so the grid does not outgrow the number of the faces
+            std::int64_t cellSize = _maxDistance;
+            std::int64_t gridWidth, gridHeight;
+            while (true) {
+                gridWidth = (maxPt.x - minPt.x) / cellSize + 1;
+                gridHeight = (maxPt.y - minPt.y) / cellSize + 1;
+                if (gridWidth * gridHeight <= 4 * static_cast<std::int64_t>(actualCount) + 16) break;
+                cellSize *= 2;
+            }
+            auto getCell = [&](cv::Point const &pt) -> std::int64_t {
+                return (pt.y - minPt.y) / cellSize * gridWidth + (pt.x - minPt.x) / cellSize;
+            };
+
+            // a counting sort of the centroids by their cells
+            _cellStarts.assign(gridWidth * gridHeight + 1, 0);
+            for (cv::Point const &pt : _actualCentroids) {
+                ++_cellStarts[getCell(pt) + 1];
+            }
+            std::partial_sum(_cellStarts.begin(), _cellStarts.end(), _cellStarts.begin());
+            _cellItems.resize(actualCount);
+            for (std::size_t j = 0; j < actualCount; ++j) {
+                _cellItems[_cellStarts[getCell(_actualCentroids[j])]++] = j;
+            }
+            // the starts were shifted to the ends of the cells by the filling
+            std::rotate(_cellStarts.rbegin(), _cellStarts.rbegin() + 1, _cellStarts.rend());
+            _cellStarts[0] = 0;
+            // <- Grid
+
+            // Nearest centroids ->
+            std::int64_t const maxSquaredDistance = static_cast<std::int64_t>(_maxDistance) * _maxDistance;
+            for (std::size_t i = 0; i < _prevCentroids.size(); ++i) {
+                cv::Point const &pt = _prevCentroids[i];
+
+                std::int64_t cellX = pt.x >= minPt.x ? (pt.x - minPt.x) / cellSize : -1;
+                std::int64_t cellY = pt.y >= minPt.y ? (pt.y - minPt.y) / cellSize : -1;
+
+                int nearest = -1;
+                std::int64_t nearestDistance = maxSquaredDistance;
+                for (std::int64_t y = std::max<std::int64_t>(cellY - 1, 0);
+                     y <= std::min(cellY + 1, gridHeight - 1); ++y) {
+                    for (std::int64_t x = std::max<std::int64_t>(cellX - 1, 0);
+                         x <= std::min(cellX + 1, gridWidth - 1); ++x) {
+                        std::int64_t cell = y * gridWidth + x;
+                        for (int k = _cellStarts[cell]; k < _cellStarts[cell + 1]; ++k) {
+                            int j = _cellItems[k];
+                            std::int64_t dx = _actualCentroids[j].x - pt.x;
+                            std::int64_t dy = _actualCentroids[j].y - pt.y;
+                            std::int64_t distance = dx * dx + dy * dy;
+                            // ties are resolved in favor of the first face
+                            if (distance < nearestDistance || (distance == nearestDistance && j < nearest)) {
+                                nearest = j;
+                                nearestDistance = distance;
+                            }
+                        }
+                    }
+                }
 
-            prevCentroids[prevIdx].x = -1;
-            actualCentroids[actualIdx].x = -1;
+                if (nearest != -1 && (_claims[nearest] == -1 || nearestDistance < _claimDistances[nearest])) {
+                    _claims[nearest] = i;
+                    _claimDistances[nearest] = nearestDistance;
+                }
+            }
+            // <- Nearest centroids
         }
 
-        for (std::size_t i = 0; i < prevCentroids.size(); ++i) {
-            if (prevCentroids[i].x != -1) {
-                res.emplace_back(-1, i);
+        for (std::size_t j = 0; j < actualCount; ++j) {
+            if (_claims[j] != -1) {
+                res.emplace_back(_claims[j], j);
+                _isPrevMatched[_claims[j]] = true;
             }
         }
-        for (std::size_t i = 0; i < actualCentroids.size(); ++i) {
-            if (actualCentroids[i].x != -1) {
+
+        for (std::size_t i = 0; i < _prevCentroids.size(); ++i) {
+            if (!_isPrevMatched[i]) {
                 res.emplace_back(i, -1);
             }
         }
+        for (std::size_t j = 0; j < actualCount; ++j) {
+            if (_claims[j] == -1) {
+                res.emplace_back(-1, j);
+            }
+        }
 
         return res;
     }
 
-    std::vector<cv::Point> CentroidTracker::_getCentroids(std::vector<Face> const &faces) {
-        std::vector<cv::Point> res;
-        std::transform(faces.begin(), faces.end(), std::back_inserter(res),
+    void CentroidTracker::_getCentroids(std::vector<Face> const &faces, std::vector<cv::Point> &centroids) {
+        centroids.clear();
+        std::transform(faces.begin(), faces.end(), std::back_inserter(centroids),
                        [](Face const &face) -> cv::Point { return (face.rect.br() + face.rect.tl()) / 2; });
-        return res;
     }
 
 
-}
\ No newline at end of file
+}
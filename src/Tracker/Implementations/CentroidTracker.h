@@ -18,7 +18,9 @@
 namespace faces {
 
     /**
-     * A nearest centroid tracker, which matches face to the one with the nearest center point
+     * A nearest centroid tracker, which matches face to the one with the nearest center point. @n
+     * The actual centroids are bucketed into a uniform grid with cells not smaller than `maxDistance`,
+     * so only the neighbouring cells are searched for each of the previous centroids
      */
     class CentroidTracker : public Tracker {
     public:
@@ -27,14 +29,23 @@ namespace faces {
     protected:
         int _maxDistance;
 
+        /// scratch buffers reused between the calls
+        std::vector<cv::Point> _prevCentroids, _actualCentroids;
+        /// indexes of the actual centroids sorted by their cells; the i-th cell is [_cellStarts[i], _cellStarts[i + 1])
+        std::vector<int> _cellItems, _cellStarts;
+        /// the nearest previous face claiming each of the actual ones and a squared distance to it
+        std::vector<int> _claims;
+        std::vector<std::int64_t> _claimDistances;
+        std::vector<bool> _isPrevMatched;
+
         std::vector<std::pair<int, int>> _track(std::vector<Face> const &prevFaces,
                                                 std::vector<Face> const &actualFaces,
                                                 cv::Mat const &prevImg, cv::Mat const &actualImg) override;
 
         /**
-         * @return a vector of center points of the given faces
+         * Fills the given vector with center points of the given faces
          */
-        [[nodiscard]] static std::vector<cv::Point> _getCentroids(std::vector<Face> const &faces);
+        static void _getCentroids(std::vector<Face> const &faces, std::vector<cv::Point> &centroids);
 
     };
 
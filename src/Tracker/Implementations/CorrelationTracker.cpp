@@ -0,0 +1,244 @@
+/**
+ * @file CorrelationTracker.cpp
+ * @author Люнгрин Андрей aka prostoichelovek <iam.prostoi.chelovek@gmail.com>
+ * @date 19 Oct 2026
+ * @copyright MIT License
+ */
+
+#include "CorrelationTracker.h"
+
+namespace faces {
+
+    CorrelationTracker::CorrelationTracker(Config const &config) {
+        try {
+            _type = config["CorrelationTracker.type"].getString();
+            _reinitInterval = config["CorrelationTracker.reinitInterval"].getInt();
+            _minIou = config["CorrelationTracker.minIou"].getNumber();
+            _maxAge = config["CorrelationTracker.maxAge"].getInt();
+        } catch (std::out_of_range &e) {
+            spdlog::error("Cannot get parameters of the CorrelationTracker from the config, using the default ones");
+        }
+
+        if (_createFilter() == nullptr) {
+            spdlog::error("Unknown type of the correlation filters: {}", _type);
+            return;
+        }
+        _ok = true;
+    }
+
+    std::vector<cv::Rect> CorrelationTracker::getCoastingRects() const {
+        std::vector<cv::Rect> res;
+        for (Filter const &filter : _coasting) {
+            res.emplace_back(filter.anchor);
+        }
+        return res;
+    }
+
+    std::vector<std::pair<int, int>> CorrelationTracker::_track(std::vector<Face> const &prevFaces,
+                                                                std::vector<Face> const &actualFaces,
+                                                                cv::Mat const &prevImg, cv::Mat const &actualImg) {
+        // the filters of the previous faces go first, and the coasting ones follow them
+        auto [filters, tracked] = _advanceFilters(prevFaces, prevImg, actualImg);
+        std::size_t visible = prevFaces.size();
+
+        std::size_t rows = tracked.size(), cols = actualFaces.size();
+        double const maxCost = 2;
+        std::vector<double> cost(rows * cols, maxCost);
+        for (std::size_t i = 0; i < rows; ++i) {
+            if (tracked[i].empty()) continue;
+
+            for (std::size_t j = 0; j < cols; ++j) {
+                double iou = getIou(tracked[i], actualFaces[j].rect);
+                if (iou >= _minIou) {
+                    cost[i * cols + j] = 1 - iou;
+                }
+            }
+        }
+
+        std::vector<int> assignment = solveAssignment(cost, rows, cols, maxCost);
+
+        // the filters are kept in the order of the actual faces
+        std::vector<std::pair<int, int>> res;
+        std::vector<Filter> actualFilters(cols);
+        std::vector<bool> isMatched(cols, false);
+        _trackIds.assign(cols, 0);
+        for (std::size_t i = 0; i < rows; ++i) {
+            Filter &filter = filters[i];
+            if (assignment[i] == -1) {
+                if (i < visible) {
+                    res.emplace_back(i, -1);
+                }
+                // the face keeps being followed while the filter does not lose it
+                if (!tracked[i].empty() && ++filter.missed <= _maxAge) {
+                    filter.anchor = tracked[i];
+                    _coasting.emplace_back(std::move(filter));
+                }
+                continue;
+            }
+
+            // a coasting filter has no face on the previous frame, but it keeps its id
+            std::size_t j = assignment[i];
+            res.emplace_back(i < visible ? static_cast<int>(i) : -1, j);
+            isMatched[j] = true;
+            _trackIds[j] = filter.id;
+
+            Filter &actualFilter = actualFilters[j];
+            actualFilter = std::move(filter);
+            if (++actualFilter.age >= _reinitInterval) {
+                actualFilter.tracker = nullptr;
+            }
+            actualFilter.anchor = actualFaces[j].rect;
+            actualFilter.missed = 0;
+        }
+        for (std::size_t j = 0; j < cols; ++j) {
+            if (!isMatched[j]) {
+                res.emplace_back(-1, j);
+                actualFilters[j].id = _nextId++;
+                actualFilters[j].anchor = actualFaces[j].rect;
+                _trackIds[j] = actualFilters[j].id;
+            }
+        }
+
+        // new and outdated filters
+        _initFilters(actualFilters, actualImg);
+        _filters = std::move(actualFilters);
+
+        return res;
+    }
+
+    std::vector<Face> CorrelationTracker::_predict(std::vector<Face> const &prevFaces,
+                                                   cv::Mat const &prevImg, cv::Mat const &actualImg) {
+        if (prevImg.empty() || actualImg.empty()) {
+            _trackIds.assign(prevFaces.size(), 0);
+            return std::vector<Face>(prevFaces.size());
+        }
+
+        auto [filters, tracked] = _advanceFilters(prevFaces, prevImg, actualImg);
+
+        std::vector<Face> res(prevFaces.size());
+        _filters.clear();
+        _trackIds.assign(prevFaces.size(), 0);
+        for (std::size_t i = 0; i < filters.size(); ++i) {
+            if (tracked[i].empty()) continue;
+
+            filters[i].anchor = tracked[i];
+            ++filters[i].age;
+            if (i >= prevFaces.size()) {
+                _coasting.emplace_back(std::move(filters[i]));
+                continue;
+            }
+
+            Face face = prevFaces[i];
+            // the image of the face is not valid for the new position
+            face.img = cv::Mat();
+            // the landmarks are relative to the rect, which is only moved
+            face.rect = tracked[i];
+            res[i] = std::move(face);
+
+            _trackIds[i] = filters[i].id;
+            _filters.emplace_back(std::move(filters[i]));
+        }
+
+        return res;
+    }
+
+    std::vector<CorrelationTracker::Filter> CorrelationTracker::_takeFilters(std::vector<Face> const &faces,
+                                                                             cv::Mat const &img) {
+        std::vector<Filter> res(faces.size());
+        std::vector<bool> isTaken(_filters.size(), false);
+        for (std::size_t i = 0; i < faces.size(); ++i) {
+            cv::Rect const &rect = faces[i].rect;
+
+            // the faces are usually passed in the same order as they were returned
+            std::size_t idx = i;
+            if (idx >= _filters.size() || isTaken[idx] || _filters[idx].anchor != rect) {
+                idx = 0;
+                while (idx < _filters.size() && (isTaken[idx] || _filters[idx].anchor != rect)) {
+                    ++idx;
+                }
+            }
+
+            if (idx < _filters.size()) {
+                res[i] = std::move(_filters[idx]);
+                isTaken[idx] = true;
+            } else {
+                res[i].id = _nextId++;
+                res[i].anchor = rect;
+            }
+        }
+        _filters.clear();
+
+        _initFilters(res, img);
+        return res;
+    }
+
+    std::pair<std::vector<CorrelationTracker::Filter>, std::vector<cv::Rect>>
+    CorrelationTracker::_advanceFilters(std::vector<Face> const &faces, cv::Mat const &prevImg,
+                                        cv::Mat const &actualImg) {
+        std::vector<Filter> filters;
+        if (prevImg.empty() || actualImg.empty()) {
+            _filters.clear();
+            _coasting.clear();
+            return {std::vector<Filter>(faces.size()), std::vector<cv::Rect>(faces.size())};
+        }
+
+        filters = _takeFilters(faces, prevImg);
+        std::move(_coasting.begin(), _coasting.end(), std::back_inserter(filters));
+        _coasting.clear();
+
+        std::vector<cv::Rect> tracked = _updateFilters(filters, actualImg);
+        return {std::move(filters), std::move(tracked)};
+    }
+
+    void CorrelationTracker::_initFilters(std::vector<Filter> &filters, cv::Mat const &img) const {
+        cv::Rect imgRect({0, 0}, img.size());
+        ThreadPool::getInstance().parallelFor(0, filters.size(), [&](std::size_t i) {
+            Filter &filter = filters[i];
+            if (filter.tracker != nullptr) return;
+
+            cv::Rect rect = filter.anchor & imgRect;
+            if (rect.empty()) return;
+
+            try {
+                filter.tracker = _createFilter();
+                filter.tracker->init(img, rect);
+                filter.age = 0;
+            } catch (cv::Exception &e) {
+                spdlog::warn("Cannot initialize a correlation filter of the face {}: {}", filter.id, e.what());
+                filter.tracker = nullptr;
+            }
+        });
+    }
+
+    std::vector<cv::Rect> CorrelationTracker::_updateFilters(std::vector<Filter> &filters, cv::Mat const &img) const {
+        cv::Rect imgRect({0, 0}, img.size());
+        std::vector<cv::Rect> res(filters.size());
+        ThreadPool::getInstance().parallelFor(0, filters.size(), [&](std::size_t i) {
+            Filter &filter = filters[i];
+            if (filter.tracker == nullptr) return;
+
+            cv::Rect rect;
+            try {
+                if (filter.tracker->update(img, rect)) {
+                    res[i] = rect & imgRect;
+                }
+            } catch (cv::Exception &e) {
+                // the face is lost, and the filter is dropped or reinitialized from a detection
+                spdlog::warn("Cannot update a correlation filter of the face {}: {}", filter.id, e.what());
+                filter.tracker = nullptr;
+            }
+        });
+        return res;
+    }
+
+    cv::Ptr<cv::Tracker> CorrelationTracker::_createFilter() const {
+        if (_type == "MOSSE") {
+            return cv::legacy::upgradeTrackingAPI(cv::legacy::TrackerMOSSE::create());
+        }
+        if (_type == "KCF") {
+            return cv::TrackerKCF::create();
+        }
+        return nullptr;
+    }
+
+}
@@ -0,0 +1,153 @@
+/**
+ * @file CorrelationTracker.h
+ * @author Люнгрин Андрей aka prostoichelovek <iam.prostoi.chelovek@gmail.com>
+ * @date 19 Oct 2026
+ * @copyright MIT License
+ *
+ * @brief This file contains a tracker, which follows each face with a correlation filter
+ */
+
+#ifndef FACES_CORRELATIONTRACKER_H
+#define FACES_CORRELATIONTRACKER_H
+
+#include <opencv2/tracking.hpp>
+#include <opencv2/tracking/tracking_legacy.hpp>
+
+#include <spdlog/spdlog.h>
+
+#include <utils/utils.h>
+#include <utils/assignment.h>
+#include <utils/ThreadPool.h>
+#include <Config/Config.h>
+
+#include <Tracker/Tracker.hpp>
+
+namespace faces {
+
+    /**
+     * A bank of the correlation filter trackers from opencv_contrib (MOSSE or KCF), one per face,
+     * so faces may be followed without the detector, which is run only from time to time. @n
+     * The filters of all of the faces are updated in parallel. On the frames with detections,
+     * the updated filters are matched with the detected faces by IoU; a matched filter is reinitialized
+     * from its detection only if it was not reinitialized for `reinitInterval` frames,
+     * and a filter is created for each new face. @n
+     * A filter, which was not matched with a detection, keeps following its face for up to `maxAge`
+     * detection frames (see @ref getCoastingRects), so it may be matched again, keeping its id
+     * reported by Tracker::getTrackIds. A filter, which fails, is dropped. @n
+     * A filter is found by the rect of the face, which it returned OR was matched with on the previous call,
+     * so the faces may be reordered or removed by the caller between the calls. @n
+     * Requires OpenCV 4.5.1 or newer built with the tracking module
+     */
+    class CorrelationTracker : public Tracker {
+    public:
+        FACES_MAIN_CONSTRUCTOR(explicit CorrelationTracker, Config const &config);
+
+        /**
+         * @return the rects, where the filters follow the faces, which were not detected on the last frames;
+         *         they may be used to restrict the detection
+         */
+        [[nodiscard]] std::vector<cv::Rect> getCoastingRects() const;
+
+    protected:
+        /**
+         * A correlation filter of a single face
+         */
+        struct Filter {
+            /// a unique id of the filter, starting from 1, which is kept when it is reinitialized
+            std::uint64_t id = 0;
+            /// the filter OR nullptr if it is not initialized
+            cv::Ptr<cv::Tracker> tracker;
+            /// a rect of the face, by which the filter is found on the next call
+            cv::Rect anchor;
+            /// a number of frames passed since the filter was initialized from a detection
+            int age = 0;
+            /// a number of consecutive detection frames where the face was not found
+            int missed = 0;
+        };
+
+        /// a type of the filters: "MOSSE" or "KCF"
+        std::string _type = "MOSSE";
+
+        /// a number of frames after which a filter is reinitialized from a matched detection
+        int _reinitInterval = 15;
+
+        /// a minimal IoU of a tracked and a detected face to match them
+        double _minIou = 0.3;
+
+        /// a number of detection frames a filter is kept without matches
+        int _maxAge = 5;
+
+        /// the filters of the faces returned by the last call
+        std::vector<Filter> _filters;
+
+        /// the filters of the faces, which were not detected, with their last rects as the anchors
+        std::vector<Filter> _coasting;
+
+        std::uint64_t _nextId = 1;
+
+        std::vector<std::pair<int, int>> _track(std::vector<Face> const &prevFaces,
+                                                std::vector<Face> const &actualFaces,
+                                                cv::Mat const &prevImg, cv::Mat const &actualImg) override;
+
+        std::vector<Face> _predict(std::vector<Face> const &prevFaces,
+                                   cv::Mat const &prevImg, cv::Mat const &actualImg) override;
+
+        /**
+         * Takes the filters of the given faces out of @ref _filters;
+         * the filters of the faces, which do not have ones, are initialized on the given image
+         *
+         * @param faces - faces to find the filters of
+         * @param img   - an image where @p faces were detected or predicted
+         *
+         * @return a filter of each of the faces
+         */
+        std::vector<Filter> _takeFilters(std::vector<Face> const &faces, cv::Mat const &img);
+
+        /**
+         * Takes the filters of the given faces with @ref _takeFilters and appends the coasting ones after them
+         *
+         * @return the filters and their updated rects (see @ref _updateFilters)
+         */
+        std::pair<std::vector<Filter>, std::vector<cv::Rect>> _advanceFilters(std::vector<Face> const &faces,
+                                                                              cv::Mat const &prevImg,
+                                                                              cv::Mat const &actualImg);
+
+        /**
+         * Initializes the filters without trackers at their anchors in parallel;
+         * the filters which cannot be initialized are left empty
+         */
+        void _initFilters(std::vector<Filter> &filters, cv::Mat const &img) const;
+
+        /**
+         * Updates the filters on the given image in parallel; the filters which fail are left empty
+         *
+         * @return a new rect of each of the filters OR an empty rect if its face is lost
+         */
+        std::vector<cv::Rect> _updateFilters(std::vector<Filter> &filters, cv::Mat const &img) const;
+
+        /**
+         * @return a new filter of the @ref _type OR nullptr if the type is unknown
+         */
+        [[nodiscard]] cv::Ptr<cv::Tracker> _createFilter() const;
+
+    };
+
+    FACES_REGISTER_SUBCLASS(Tracker, CorrelationTracker, Correlation)
+
+    FACES_AUGMENT_CONFIG(CorrelationTracker,
+                         FACES_ADD_CONFIG_OPTION("CorrelationTracker.type", "correlationType", "MOSSE", false,
+                                                 "A type of the correlation filters: MOSSE or KCF")
+                                 FACES_ADD_CONFIG_OPTION("CorrelationTracker.reinitInterval", "reinitInterval", 15,
+                                                         false, "A number of frames after which a filter "
+                                                                "is reinitialized from a detection")
+                                 FACES_ADD_CONFIG_OPTION("CorrelationTracker.minIou", "correlationMinIou", 0.3,
+                                                         false, "A minimal IoU of a tracked and a detected face "
+                                                                "to match them")
+                                 FACES_ADD_CONFIG_OPTION("CorrelationTracker.maxAge", "correlationMaxAge", 5,
+                                                         false, "A number of detection frames a filter follows "
+                                                                "a face, which was not detected")
+    )
+
+}
+
+#endif //FACES_CORRELATIONTRACKER_H
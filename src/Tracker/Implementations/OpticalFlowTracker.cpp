@@ -0,0 +1,232 @@
+/**
+ * @file OpticalFlowTracker.cpp
+ * @author Люнгрин Андрей aka prostoichelovek <iam.prostoi.chelovek@gmail.com>
+ * @date 19 Oct 2026
+ * @copyright MIT License
+ */
+
+#include "OpticalFlowTracker.h"
+
+namespace faces {
+
+    namespace {
+
+        /**
+         * @return a median of the given values, which are reordered
+         */
+        float median(std::vector<float> &values) {
+            auto middle = values.begin() + values.size() / 2;
+            std::nth_element(values.begin(), middle, values.end());
+            return *middle;
+        }
+
+    }
+
+    OpticalFlowTracker::OpticalFlowTracker(Config const &config) {
+        _ok = true;
+
+        try {
+            _winSize = config["OpticalFlowTracker.winSize"].getInt();
+            _maxLevel = config["OpticalFlowTracker.maxLevel"].getInt();
+            _gridSize = config["OpticalFlowTracker.gridSize"].getInt();
+            _maxError = config["OpticalFlowTracker.maxError"].getNumber();
+            _minPoints = config["OpticalFlowTracker.minPoints"].getInt();
+            _minIou = config["OpticalFlowTracker.minIou"].getNumber();
+        } catch (std::out_of_range &e) {
+            spdlog::error("Cannot get parameters of the OpticalFlowTracker from the config, using the default ones");
+        }
+    }
+
+    std::vector<std::pair<int, int>> OpticalFlowTracker::_track(std::vector<Face> const &prevFaces,
+                                                                std::vector<Face> const &actualFaces,
+                                                                cv::Mat const &prevImg, cv::Mat const &actualImg) {
+        std::vector<Face> propagated = _predict(prevFaces, prevImg, actualImg);
+
+        std::size_t rows = propagated.size(), cols = actualFaces.size();
+        double const maxCost = 2;
+        std::vector<double> cost(rows * cols, maxCost);
+        for (std::size_t i = 0; i < rows; ++i) {
+            if (propagated[i].rect.empty()) continue;
+
+            for (std::size_t j = 0; j < cols; ++j) {
+                double iou = getIou(propagated[i].rect, actualFaces[j].rect);
+                if (iou >= _minIou) {
+                    cost[i * cols + j] = 1 - iou;
+                }
+            }
+        }
+
+        std::vector<int> assignment = solveAssignment(cost, rows, cols, maxCost);
+
+        std::vector<std::pair<int, int>> res;
+        std::vector<bool> isMatched(cols, false);
+        for (std::size_t i = 0; i < rows; ++i) {
+            res.emplace_back(i, assignment[i]);
+            if (assignment[i] != -1) {
+                isMatched[assignment[i]] = true;
+            }
+        }
+        for (std::size_t j = 0; j < cols; ++j) {
+            if (!isMatched[j]) {
+                res.emplace_back(-1, j);
+            }
+        }
+
+        return res;
+    }
+
+    std::vector<Face> OpticalFlowTracker::_predict(std::vector<Face> const &prevFaces,
+                                                   cv::Mat const &prevImg, cv::Mat const &actualImg) {
+        if (prevImg.empty() || actualImg.empty()) {
+            return std::vector<Face>(prevFaces.size());
+        }
+
+        // Pyramids ->
+        std::optional<std::size_t> prevIndex, actualIndex;
+        if (_frameIndexes) {
+            prevIndex = _frameIndexes->first;
+            actualIndex = _frameIndexes->second;
+        }
+
+        std::vector<cv::Mat> prevPyramid, actualPyramid;
+        _getPyramid(prevImg, prevIndex, prevPyramid);
+        _getPyramid(actualImg, actualIndex, actualPyramid);
+
+        // without the indexes nothing can be reused safely
+        _prevPyramid = {prevIndex.value_or(0), prevIndex ? prevPyramid : std::vector<cv::Mat>()};
+        _lastPyramid = {actualIndex.value_or(0), actualIndex ? actualPyramid : std::vector<cv::Mat>()};
+        // <- Pyramids
+
+        // Points ->
+        _points.clear();
+        std::vector<std::size_t> offsets;
+        for (Face const &face : prevFaces) {
+            offsets.emplace_back(_points.size());
+
+            cv::Rect const &rect = face.rect;
+            for (cv::Point const &pt : face.getRectLandmarks()) {
+                _points.emplace_back(pt);
+            }
+
+            _points.emplace_back(rect.x, rect.y);
+            _points.emplace_back(rect.x + rect.width, rect.y);
+            _points.emplace_back(rect.x + rect.width, rect.y + rect.height);
+            _points.emplace_back(rect.x, rect.y + rect.height);
+
+            for (int y = 1; y <= _gridSize; ++y) {
+                for (int x = 1; x <= _gridSize; ++x) {
+                    _points.emplace_back(rect.x + rect.width * x / (_gridSize + 1.0f),
+                                         rect.y + rect.height * y / (_gridSize + 1.0f));
+                }
+            }
+        }
+        offsets.emplace_back(_points.size());
+
+        if (_points.empty()) {
+            return std::vector<Face>(prevFaces.size());
+        }
+        // <- Points
+
+        // Forward-backward flow ->
+        cv::Size winSize(_winSize, _winSize);
+        cv::calcOpticalFlowPyrLK(prevPyramid, actualPyramid, _points, _forward,
+                                 _forwardStatus, _errors, winSize, _maxLevel);
+        cv::calcOpticalFlowPyrLK(actualPyramid, prevPyramid, _forward, _backward,
+                                 _backwardStatus, _errors, winSize, _maxLevel);
+
+        std::vector<bool> status(_points.size());
+        for (std::size_t i = 0; i < _points.size(); ++i) {
+            status[i] = _forwardStatus[i] && _backwardStatus[i] && cv::norm(_points[i] - _backward[i]) <= _maxError;
+        }
+        // <- Forward-backward flow
+
+        cv::Rect imgRect({0, 0}, actualImg.size());
+        std::vector<Face> res(prevFaces.size());
+        for (std::size_t i = 0; i < prevFaces.size(); ++i) {
+            Face face = prevFaces[i];
+            // the image of the face is not valid for the new position
+            face.img = cv::Mat();
+
+            if (_moveFace(face, offsets[i], offsets[i + 1], status, imgRect)) {
+                res[i] = std::move(face);
+            }
+        }
+
+        return res;
+    }
+
+    void OpticalFlowTracker::_getPyramid(cv::Mat const &img, std::optional<std::size_t> frameIndex,
+                                         std::vector<cv::Mat> &pyramid) const {
+        if (frameIndex) {
+            for (CachedPyramid const *cached : {&_lastPyramid, &_prevPyramid}) {
+                if (!cached->levels.empty() && cached->frameIndex == *frameIndex) {
+                    pyramid = cached->levels;
+                    return;
+                }
+            }
+        }
+        _buildPyramid(img, pyramid);
+    }
+
+    void OpticalFlowTracker::_buildPyramid(cv::Mat const &img, std::vector<cv::Mat> &pyramid) const {
+        cv::Mat gray = img;
+        if (img.channels() == 3) {
+            cv::cvtColor(img, gray, cv::COLOR_BGR2GRAY);
+        }
+        cv::buildOpticalFlowPyramid(gray, pyramid, cv::Size(_winSize, _winSize), _maxLevel);
+    }
+
+    bool OpticalFlowTracker::_moveFace(Face &face, std::size_t begin, std::size_t end,
+                                       std::vector<bool> const &status, cv::Rect const &imgRect) const {
+        std::vector<std::size_t> tracked;
+        for (std::size_t i = begin; i < end; ++i) {
+            if (status[i]) {
+                tracked.emplace_back(i);
+            }
+        }
+        if (tracked.size() < static_cast<std::size_t>(std::max(_minPoints, 2))) {
+            return false;
+        }
+
+        // a median shift and a median change of the distances between the points, as in the Median Flow
+        std::vector<float> dxs, dys, scales;
+        for (std::size_t k = 0; k < tracked.size(); ++k) {
+            std::size_t i = tracked[k];
+            dxs.emplace_back(_forward[i].x - _points[i].x);
+            dys.emplace_back(_forward[i].y - _points[i].y);
+
+            for (std::size_t l = k + 1; l < tracked.size(); ++l) {
+                std::size_t j = tracked[l];
+                double prevDist = cv::norm(_points[i] - _points[j]);
+                if (prevDist > 1) {
+                    scales.emplace_back(cv::norm(_forward[i] - _forward[j]) / prevDist);
+                }
+            }
+        }
+        cv::Point2f shift(median(dxs), median(dys));
+        float scale = scales.empty() ? 1.0f : median(scales);
+
+        cv::Rect const &rect = face.rect;
+        cv::Point2f center(rect.x + rect.width / 2.0f, rect.y + rect.height / 2.0f);
+        cv::Point2f newCenter = center + shift;
+        cv::Size2f newSize(rect.width * scale, rect.height * scale);
+        cv::Rect newRect(cvRound(newCenter.x - newSize.width / 2), cvRound(newCenter.y - newSize.height / 2),
+                         cvRound(newSize.width), cvRound(newSize.height));
+        // the landmarks are relative to the clipped rect
+        newRect &= imgRect;
+        if (newRect.empty()) {
+            return false;
+        }
+
+        // the landmarks are the first points of the face
+        for (std::size_t k = 0; k < face.landmarks.size(); ++k) {
+            std::size_t i = begin + k;
+            cv::Point2f pt = status[i] ? _forward[i] : newCenter + (_points[i] - center) * scale;
+            face.landmarks[k] = cv::Point(cvRound(pt.x), cvRound(pt.y)) - newRect.tl();
+        }
+        face.rect = newRect;
+
+        return true;
+    }
+
+}
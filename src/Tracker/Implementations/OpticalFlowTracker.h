@@ -0,0 +1,136 @@
+/**
+ * @file OpticalFlowTracker.h
+ * @author Люнгрин Андрей aka prostoichelovek <iam.prostoi.chelovek@gmail.com>
+ * @date 19 Oct 2026
+ * @copyright MIT License
+ *
+ * @brief This file contains a tracker, which moves faces by the optical flow of their points
+ */
+
+#ifndef FACES_OPTICALFLOWTRACKER_H
+#define FACES_OPTICALFLOWTRACKER_H
+
+#include <opencv2/video/tracking.hpp>
+
+#include <spdlog/spdlog.h>
+
+#include <utils/utils.h>
+#include <utils/assignment.h>
+#include <Config/Config.h>
+
+#include <Tracker/Tracker.hpp>
+
+namespace faces {
+
+    /**
+     * A tracker, which follows landmarks, box corners and a grid of inner points of each face
+     * with the pyramidal Lucas-Kanade optical flow, so faces may be propagated through the frames
+     * where the detector does not run. @n
+     * The image pyramid is built once per frame and shared by all of the faces; the pyramids of the last call
+     * are kept by the indexes of their frames (see Tracker::setFrameIndexes) to be reused on the next one. @n
+     * The points are tracked forward and then backward, and the points which do not return close to
+     * their initial positions are dropped; a face is moved and scaled by the median of the motion
+     * of the remaining points, and it is lost if too few of them remain
+     */
+    class OpticalFlowTracker : public Tracker {
+    public:
+        FACES_MAIN_CONSTRUCTOR(explicit OpticalFlowTracker, Config const &config);
+
+    protected:
+        /// a size of the search window at each pyramid level
+        int _winSize = 21;
+
+        /// a maximal pyramid level number
+        int _maxLevel = 3;
+
+        /// a number of inner points per side of a face
+        int _gridSize = 4;
+
+        /// a maximal forward-backward error in pixels of a tracked point
+        double _maxError = 1.0;
+
+        /// a minimal number of tracked points for a face not to be lost
+        int _minPoints = 4;
+
+        /// a minimal IoU of a propagated and a detected face to match them
+        double _minIou = 0.3;
+
+        /**
+         * A pyramid of a frame kept between the calls
+         */
+        struct CachedPyramid {
+            std::size_t frameIndex = 0;
+            std::vector<cv::Mat> levels;
+        };
+
+        /// the pyramids of the previous and the current frames of the last call with the frame indexes
+        CachedPyramid _prevPyramid, _lastPyramid;
+
+        /// scratch buffers reused between the calls
+        std::vector<cv::Point2f> _points, _forward, _backward;
+        std::vector<uchar> _forwardStatus, _backwardStatus;
+        std::vector<float> _errors;
+
+        std::vector<std::pair<int, int>> _track(std::vector<Face> const &prevFaces,
+                                                std::vector<Face> const &actualFaces,
+                                                cv::Mat const &prevImg, cv::Mat const &actualImg) override;
+
+        std::vector<Face> _predict(std::vector<Face> const &prevFaces,
+                                   cv::Mat const &prevImg, cv::Mat const &actualImg) override;
+
+        /**
+         * Builds a pyramid of the given image
+         *
+         * @param img     - a BGR or grayscale image
+         * @param pyramid - a destination of the pyramid
+         */
+        void _buildPyramid(cv::Mat const &img, std::vector<cv::Mat> &pyramid) const;
+
+        /**
+         * Takes a pyramid of the frame with the given index from the cache or builds it
+         *
+         * @param img        - the frame
+         * @param frameIndex - an index of the frame OR nothing if it is not known
+         * @param pyramid    - a destination of the pyramid
+         */
+        void _getPyramid(cv::Mat const &img, std::optional<std::size_t> frameIndex,
+                         std::vector<cv::Mat> &pyramid) const;
+
+        /**
+         * Moves the given face by the motion of its tracked points and clips it by the image
+         *
+         * @param face       - a face to move
+         * @param begin, end - a range of the points of the face in the scratch buffers,
+         *                     starting with its landmarks
+         * @param status     - whether each of the points was tracked
+         * @param imgRect    - a rect of the image
+         *
+         * @return whether enough of the points were tracked and the face is still on the image
+         */
+        bool _moveFace(Face &face, std::size_t begin, std::size_t end, std::vector<bool> const &status,
+                       cv::Rect const &imgRect) const;
+
+    };
+
+    FACES_REGISTER_SUBCLASS(Tracker, OpticalFlowTracker, OpticalFlow)
+
+    FACES_AUGMENT_CONFIG(OpticalFlowTracker,
+                         FACES_ADD_CONFIG_OPTION("OpticalFlowTracker.winSize", "flowWinSize", 21, false,
+                                                 "A size of the optical flow search window")
+                                 FACES_ADD_CONFIG_OPTION("OpticalFlowTracker.maxLevel", "flowMaxLevel", 3, false,
+                                                         "A maximal level of the optical flow image pyramid")
+                                 FACES_ADD_CONFIG_OPTION("OpticalFlowTracker.gridSize", "flowGridSize", 4, false,
+                                                         "A number of tracked inner points per side of a face")
+                                 FACES_ADD_CONFIG_OPTION("OpticalFlowTracker.maxError", "flowMaxError", 1.0,
+                                                         false, "A maximal forward-backward error in pixels "
+                                                                "of a tracked point")
+                                 FACES_ADD_CONFIG_OPTION("OpticalFlowTracker.minPoints", "flowMinPoints", 4, false,
+                                                         "A minimal number of tracked points of a face")
+                                 FACES_ADD_CONFIG_OPTION("OpticalFlowTracker.minIou", "flowMinIou", 0.3, false,
+                                                         "A minimal IoU of a propagated and a detected face "
+                                                         "to match them")
+    )
+
+}
+
+#endif //FACES_OPTICALFLOWTRACKER_H
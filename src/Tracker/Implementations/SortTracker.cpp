@@ -0,0 +1,221 @@
+/**
+ * @file SortTracker.cpp
+ * @author Люнгрин Андрей aka prostoichelovek <iam.prostoi.chelovek@gmail.com>
+ * @date 19 Oct 2026
+ * @copyright MIT License
+ */
+
+#include "SortTracker.h"
+
+namespace faces {
+
+    SortTracker::SortTracker(Config const &config) {
+        _ok = true;
+
+        try {
+            _maxAge = config["SortTracker.maxAge"].getInt();
+            _minIou = config["SortTracker.minIou"].getNumber();
+            _maxDistance = config["SortTracker.maxDistance"].getNumber();
+            _distanceWeight = config["SortTracker.distanceWeight"].getNumber();
+        } catch (std::out_of_range &e) {
+            spdlog::error("Cannot get parameters of the SortTracker from the config, using the default ones");
+        }
+    }
+
+    std::vector<std::pair<int, int>> SortTracker::_track(std::vector<Face> const &prevFaces,
+                                                         std::vector<Face> const &actualFaces,
+                                                         cv::Mat const &prevImg, cv::Mat const &actualImg) {
+        _sync(prevFaces);
+        _predictTracks();
+
+        // Matching ->
+        std::size_t rows = _tracks.size(), cols = actualFaces.size();
+        double maxCost = 1 + _distanceWeight * _maxDistance + 1;
+        _cost.assign(rows * cols, maxCost);
+        for (std::size_t i = 0; i < rows; ++i) {
+            cv::Rect2d const &prediction = _predictions[i];
+            cv::Point2d predictionCenter = (prediction.tl() + prediction.br()) / 2;
+            double size = std::sqrt(std::max(prediction.area(), 1.0));
+
+            for (std::size_t j = 0; j < cols; ++j) {
+                cv::Rect2d detection = actualFaces[j].rect;
+                cv::Point2d detectionCenter = (detection.tl() + detection.br()) / 2;
+
+                double iou = getIou(prediction, detection);
+                double distance = cv::norm(predictionCenter - detectionCenter) / size;
+                if (iou < _minIou && distance > _maxDistance) continue;
+
+                _cost[i * cols + j] = 1 - iou + _distanceWeight * std::min(distance, _maxDistance);
+            }
+        }
+
+        std::vector<int> assignment = solveAssignment(_cost, rows, cols, maxCost);
+        // <- Matching
+
+        std::vector<std::pair<int, int>> res;
+        std::vector<bool> isMatched(cols, false);
+        _trackIds.assign(cols, 0);
+        for (std::size_t i = 0; i < rows; ++i) {
+            Track &track = _tracks[i];
+            int actualIdx = assignment[i];
+
+            if (actualIdx == -1) {
+                if (track.faceIdx != -1) {
+                    res.emplace_back(track.faceIdx, -1);
+                }
+                track.faceIdx = -1;
+                track.rect = _predictions[i];
+                ++track.missed;
+                continue;
+            }
+
+            // a coasting track has no face on the previous frame, but it keeps its id
+            res.emplace_back(track.faceIdx, actualIdx);
+            isMatched[actualIdx] = true;
+            _trackIds[actualIdx] = track.id;
+
+            track.rect = actualFaces[actualIdx].rect;
+            track.filter.correct(_toMeasurement(track.rect));
+            track.faceIdx = actualIdx;
+            track.missed = 0;
+            ++track.hits;
+        }
+
+        _tracks.erase(std::remove_if(_tracks.begin(), _tracks.end(),
+                                     [this](Track const &track) { return track.missed > _maxAge; }),
+                      _tracks.end());
+
+        for (std::size_t j = 0; j < cols; ++j) {
+            if (isMatched[j]) continue;
+
+            res.emplace_back(-1, j);
+            _tracks.emplace_back(_createTrack(actualFaces[j].rect, j));
+            _trackIds[j] = _tracks.back().id;
+        }
+
+        return res;
+    }
+
+    std::vector<Face> SortTracker::_predict(std::vector<Face> const &prevFaces,
+                                            cv::Mat const &prevImg, cv::Mat const &actualImg) {
+        _sync(prevFaces);
+        _predictTracks();
+
+        cv::Rect imgRect({0, 0}, actualImg.size());
+        std::vector<Face> res(prevFaces.size());
+        _trackIds.assign(prevFaces.size(), 0);
+        for (std::size_t i = 0; i < _tracks.size(); ++i) {
+            Track &track = _tracks[i];
+            cv::Rect rect = cv::Rect(_predictions[i]) & imgRect;
+
+            if (track.faceIdx != -1) {
+                Face &face = res[track.faceIdx];
+                if (!rect.empty()) {
+                    face = prevFaces[track.faceIdx];
+                    // the image of the face is not valid for the new position
+                    face.img = cv::Mat();
+                    face.rect = rect;
+                    _trackIds[track.faceIdx] = track.id;
+                } else {
+                    track.faceIdx = -1;
+                }
+            }
+            track.rect = rect;
+        }
+
+        return res;
+    }
+
+    void SortTracker::_sync(std::vector<Face> const &prevFaces) {
+        std::size_t visibleCount = 0;
+        bool isSynced = true;
+        for (Track const &track : _tracks) {
+            if (track.faceIdx == -1) continue;
+
+            ++visibleCount;
+            if (static_cast<std::size_t>(track.faceIdx) >= prevFaces.size()
+                || prevFaces[track.faceIdx].rect != track.rect) {
+                isSynced = false;
+                break;
+            }
+        }
+        // the faces lost by @ref _predict have empty rects and no tracks
+        auto facesCount = std::count_if(prevFaces.begin(), prevFaces.end(),
+                                        [](Face const &face) { return !face.rect.empty(); });
+        if (isSynced && visibleCount == static_cast<std::size_t>(facesCount)) {
+            return;
+        }
+
+        _tracks.clear();
+        for (std::size_t i = 0; i < prevFaces.size(); ++i) {
+            if (prevFaces[i].rect.empty()) continue;
+            _tracks.emplace_back(_createTrack(prevFaces[i].rect, i));
+        }
+    }
+
+    void SortTracker::_predictTracks() {
+        _predictions.clear();
+        for (Track &track : _tracks) {
+            cv::Mat &state = track.filter.statePost;
+            // the area should not become negative
+            if (state.at<float>(2) + state.at<float>(6) <= 0) {
+                state.at<float>(6) = 0;
+            }
+
+            _predictions.emplace_back(_toRect(track.filter.predict()));
+        }
+    }
+
+    SortTracker::Track SortTracker::_createTrack(cv::Rect const &rect, int faceIdx) {
+        Track track;
+        track.id = _nextId++;
+        track.rect = rect;
+        track.faceIdx = faceIdx;
+        track.hits = 1;
+
+        cv::KalmanFilter &filter = track.filter;
+        filter.init(7, 4, 0, CV_32F);
+
+        cv::setIdentity(filter.transitionMatrix);
+        filter.transitionMatrix.at<float>(0, 4) = 1;
+        filter.transitionMatrix.at<float>(1, 5) = 1;
+        filter.transitionMatrix.at<float>(2, 6) = 1;
+        cv::setIdentity(filter.measurementMatrix);
+
+        // the same noise parameters as in the original SORT
+        cv::setIdentity(filter.measurementNoiseCov);
+        filter.measurementNoiseCov.at<float>(2, 2) = 10;
+        filter.measurementNoiseCov.at<float>(3, 3) = 10;
+
+        cv::setIdentity(filter.processNoiseCov);
+        filter.processNoiseCov.at<float>(4, 4) = 0.01;
+        filter.processNoiseCov.at<float>(5, 5) = 0.01;
+        filter.processNoiseCov.at<float>(6, 6) = 0.0001;
+
+        // the velocities are unknown
+        cv::setIdentity(filter.errorCovPost, 10);
+        filter.errorCovPost.at<float>(4, 4) = 10000;
+        filter.errorCovPost.at<float>(5, 5) = 10000;
+        filter.errorCovPost.at<float>(6, 6) = 10000;
+
+        filter.statePost = cv::Mat::zeros(7, 1, CV_32F);
+        _toMeasurement(rect).copyTo(filter.statePost.rowRange(0, 4));
+
+        return track;
+    }
+
+    cv::Mat SortTracker::_toMeasurement(cv::Rect2d const &rect) {
+        double height = std::max(rect.height, 1.0);
+        return (cv::Mat_<float>(4, 1) << rect.x + rect.width / 2, rect.y + rect.height / 2,
+                rect.area(), rect.width / height);
+    }
+
+    cv::Rect2d SortTracker::_toRect(cv::Mat const &state) {
+        double area = std::max(state.at<float>(2), 0.0f);
+        double aspect = std::max(state.at<float>(3), 1e-3f);
+        double width = std::sqrt(area * aspect);
+        double height = width > 0 ? area / width : 0;
+        return {state.at<float>(0) - width / 2, state.at<float>(1) - height / 2, width, height};
+    }
+
+}
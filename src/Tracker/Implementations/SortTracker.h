@@ -0,0 +1,147 @@
+/**
+ * @file SortTracker.h
+ * @author Люнгрин Андрей aka prostoichelovek <iam.prostoi.chelovek@gmail.com>
+ * @date 19 Oct 2026
+ * @copyright MIT License
+ *
+ * @brief This file contains a SORT-like tracker with a Kalman filter per face
+ */
+
+#ifndef FACES_SORTTRACKER_H
+#define FACES_SORTTRACKER_H
+
+#include <cstdint>
+
+#include <opencv2/video/tracking.hpp>
+
+#include <spdlog/spdlog.h>
+
+#include <utils/utils.h>
+#include <utils/assignment.h>
+#include <Config/Config.h>
+
+#include <Tracker/Tracker.hpp>
+
+namespace faces {
+
+    /**
+     * A SORT-like tracker, which predicts a position of each face with a constant velocity Kalman filter
+     * and optimally matches the predictions to the detected faces by their IoU and distance. @n
+     * A face, which was not detected, keeps coasting on its predictions for up to `maxAge` detection frames,
+     * so it may be matched again, keeping its track id; such a face has no match on the previous frame,
+     * so the id is reported by Tracker::getTrackIds. @n
+     * The tracker is stateful: it expects @p prevFaces to be the faces given as @p actualFaces
+     * (or returned by @ref predict) on the previous call, and starts over otherwise
+     *
+     * @see https://arxiv.org/abs/1602.00763
+     */
+    class SortTracker : public Tracker {
+    public:
+        /**
+         * A tracked face
+         */
+        struct Track {
+            /// a unique id of the track, starting from 1
+            std::uint64_t id = 0;
+
+            /// a filter with the state [cx, cy, area, aspect ratio, vx, vy, varea]
+            cv::KalmanFilter filter;
+
+            /// a rect of the face on the last frame
+            cv::Rect rect;
+
+            /// an index of the face on the last frame OR -1 if the track is coasting
+            int faceIdx = -1;
+
+            /// a number of consecutive detection frames where the face was not found
+            int missed = 0;
+
+            /// a number of detections matched to the track
+            int hits = 0;
+        };
+
+        FACES_MAIN_CONSTRUCTOR(explicit SortTracker, Config const &config);
+
+        /**
+         * @return all of the current tracks, including the coasting ones,
+         *         which have their predicted rects and may be used to restrict the detection
+         */
+        [[nodiscard]] std::vector<Track> const &getTracks() const {
+            return _tracks;
+        }
+
+    protected:
+        /// a number of detection frames a track is kept without matches
+        int _maxAge = 5;
+
+        /// a minimal IoU of a prediction and a detection to match them, unless they are close enough
+        double _minIou = 0.1;
+
+        /// a maximal distance between centers of a prediction and a detection, relative to the face size
+        double _maxDistance = 1.0;
+
+        /// a weight of the relative distance in the matching cost, which is `1 - IoU + weight * distance`
+        double _distanceWeight = 0.5;
+
+        std::vector<Track> _tracks;
+
+        std::uint64_t _nextId = 1;
+
+        /// scratch buffers reused between the calls
+        std::vector<double> _cost;
+        std::vector<cv::Rect2d> _predictions;
+
+        std::vector<std::pair<int, int>> _track(std::vector<Face> const &prevFaces,
+                                                std::vector<Face> const &actualFaces,
+                                                cv::Mat const &prevImg, cv::Mat const &actualImg) override;
+
+        std::vector<Face> _predict(std::vector<Face> const &prevFaces,
+                                   cv::Mat const &prevImg, cv::Mat const &actualImg) override;
+
+        /**
+         * Checks that the visible tracks correspond to the given faces and creates new tracks for them otherwise
+         */
+        void _sync(std::vector<Face> const &prevFaces);
+
+        /**
+         * Advances filters of all of the tracks by a frame, filling @ref _predictions
+         */
+        void _predictTracks();
+
+        /**
+         * @return a new track with the filter initialized by the given rect
+         */
+        Track _createTrack(cv::Rect const &rect, int faceIdx);
+
+        /**
+         * @return a measurement vector [cx, cy, area, aspect ratio] of the given rect
+         */
+        [[nodiscard]] static cv::Mat _toMeasurement(cv::Rect2d const &rect);
+
+        /**
+         * @return a rect encoded in the given state
+         */
+        [[nodiscard]] static cv::Rect2d _toRect(cv::Mat const &state);
+
+    };
+
+    FACES_REGISTER_SUBCLASS(Tracker, SortTracker, Sort)
+
+    FACES_AUGMENT_CONFIG(SortTracker,
+                         FACES_ADD_CONFIG_OPTION("SortTracker.maxAge", "sortMaxAge", 5, false,
+                                                 "A number of detection frames a lost face is kept predicted")
+                                 FACES_ADD_CONFIG_OPTION("SortTracker.minIou", "sortMinIou", 0.1, false,
+                                                         "A minimal IoU of a predicted and a detected face "
+                                                         "to match them")
+                                 FACES_ADD_CONFIG_OPTION("SortTracker.maxDistance", "sortMaxDistance", 1.0,
+                                                         false, "A maximal distance between a predicted and "
+                                                                "a detected face relative to the face size "
+                                                                "to match them")
+                                 FACES_ADD_CONFIG_OPTION("SortTracker.distanceWeight", "sortDistanceWeight", 0.5,
+                                                         false, "A weight of the relative distance in the cost "
+                                                                "of matching a predicted and a detected face")
+    )
+
+}
+
+#endif //FACES_SORTTRACKER_H
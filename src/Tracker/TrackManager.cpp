@@ -0,0 +1,227 @@
+/**
+ * @file TrackManager.cpp
+ * @author Люнгрин Андрей aka prostoichelovek <iam.prostoi.chelovek@gmail.com>
+ * @date 19 Oct 2026
+ * @copyright MIT License
+ */
+
+#include "TrackManager.h"
+
+namespace faces {
+
+    TrackManager::TrackManager(Tracker *tracker, std::size_t maxMisses)
+            : _tracker(tracker), _maxMisses(maxMisses) {}
+
+    TrackManager::TrackManager(Tracker *tracker, Config const &config)
+            : _tracker(tracker) {
+        try {
+            _maxMisses = std::max(0, config["TrackManager.maxMisses"].getInt());
+        } catch (std::out_of_range &e) {
+            spdlog::error("Cannot get an option 'TrackManager.maxMisses' from the config!");
+        }
+    }
+
+    void TrackManager::update(std::vector<Face> &faces, cv::Mat const &img) {
+        bool hasIds = !faces.empty() && std::all_of(faces.begin(), faces.end(),
+                                                    [this](Face const &face) { return get(face.trackId) != nullptr; });
+
+        std::vector<std::pair<int, int>> matches;
+        std::vector<std::uint64_t> trackerIds;
+        if (hasIds) {
+            std::unordered_map<TrackId, int> prevIdxs;
+            for (std::size_t i = 0; i < _frameTracks.size(); ++i) {
+                prevIdxs[_frameTracks[i]] = i;
+            }
+            for (std::size_t i = 0; i < faces.size(); ++i) {
+                auto it = prevIdxs.find(faces[i].trackId);
+                matches.emplace_back(it == prevIdxs.end() ? -1 : it->second, i);
+            }
+        } else if (_tracker != nullptr && !_prevImg.empty()) {
+            _tracker->setFrameIndexes(_frameIndex, _frameIndex + 1);
+            matches = _tracker->track(_trackerFaces, faces, _prevImg, img);
+            trackerIds = _tracker->getTrackIds();
+        }
+
+        _update(faces, matches, trackerIds, img);
+    }
+
+    void TrackManager::update(std::vector<Face> &faces, std::vector<std::pair<int, int>> const &matches,
+                              cv::Mat const &img) {
+        _update(faces, matches, {}, img);
+    }
+
+    void TrackManager::_update(std::vector<Face> &faces, std::vector<std::pair<int, int>> const &matches,
+                               std::vector<std::uint64_t> const &trackerIds, cv::Mat const &img) {
+        ++_frameIndex;
+
+        std::vector<TrackId> ids(faces.size(), 0);
+        std::unordered_set<TrackId> matched;
+        for (auto const &[prevIdx, actualIdx] : matches) {
+            if (prevIdx < 0 || actualIdx < 0
+                || prevIdx >= static_cast<int>(_frameTracks.size()) || actualIdx >= static_cast<int>(faces.size())
+                || matched.count(_frameTracks[prevIdx]) != 0 || ids[actualIdx] != 0) {
+                continue;
+            }
+
+            ids[actualIdx] = _frameTracks[prevIdx];
+            matched.emplace(ids[actualIdx]);
+        }
+
+        // a face without a match on the previous frame may still be followed by the same track of the tracker
+        for (std::size_t i = 0; i < faces.size() && i < trackerIds.size(); ++i) {
+            auto it = _trackerTracks.find(trackerIds[i]);
+            if (ids[i] != 0 || trackerIds[i] == 0 || it == _trackerTracks.end()
+                || get(it->second) == nullptr || matched.count(it->second) != 0) {
+                continue;
+            }
+
+            ids[i] = it->second;
+            matched.emplace(ids[i]);
+        }
+
+        // the tracks without faces are kept for a while
+        std::vector<TrackId> missed;
+        for (std::vector<TrackId> const *tracks : {&_frameTracks, &_missedTracks}) {
+            for (TrackId id : *tracks) {
+                if (matched.count(id) != 0) continue;
+
+                TrackInfo *track = get(id);
+                if (track != nullptr && ++track->missed > _maxMisses) {
+                    _kill(id);
+                } else if (track != nullptr) {
+                    missed.emplace_back(id);
+                }
+            }
+        }
+        _missedTracks = std::move(missed);
+
+        std::vector<TrackId> born;
+        _trackerFaces.resize(faces.size());
+        for (std::size_t i = 0; i < faces.size(); ++i) {
+            Face &face = faces[i];
+
+            if (ids[i] == 0) {
+                ids[i] = _create();
+                born.emplace_back(ids[i]);
+            } else {
+                ++get(ids[i])->age;
+            }
+            face.trackId = ids[i];
+
+            if (i < trackerIds.size() && trackerIds[i] != 0) {
+                Slot &slot = _slots[static_cast<std::uint32_t>(ids[i])];
+                if (slot.trackerId != trackerIds[i]) {
+                    _trackerTracks.erase(slot.trackerId);
+                    slot.trackerId = trackerIds[i];
+                }
+                _trackerTracks[trackerIds[i]] = ids[i];
+            }
+
+            TrackInfo &track = *get(ids[i]);
+            track.missed = 0;
+            track.rect = face.rect;
+            track.landmarks = face.landmarks;
+            track.quality = face.quality;
+            if (face.label >= 0) {
+                track.label = face.label;
+            }
+
+            Face &trackerFace = _trackerFaces[i];
+            trackerFace.rect = face.rect;
+            trackerFace.landmarks = face.landmarks;
+            trackerFace.label = face.label;
+            trackerFace.quality = face.quality;
+            trackerFace.trackId = face.trackId;
+        }
+
+        _frameTracks = std::move(ids);
+        _prevImg = img;
+
+        for (TrackId id : born) {
+            for (Callback const &callback : _birthCallbacks) {
+                callback(*get(id));
+            }
+        }
+    }
+
+    std::vector<Face> TrackManager::predict(cv::Mat const &img) {
+        if (_tracker == nullptr || _prevImg.empty()) {
+            return {};
+        }
+
+        // the frame is given to @ref update next, so it gets the next index
+        _tracker->setFrameIndexes(_frameIndex, _frameIndex + 1);
+        std::vector<Face> predicted = _tracker->predict(_trackerFaces, _prevImg, img);
+        predicted.erase(std::remove_if(predicted.begin(), predicted.end(),
+                                       [](Face const &face) { return face.rect.empty(); }),
+                        predicted.end());
+        return predicted;
+    }
+
+    TrackInfo *TrackManager::get(TrackId id) {
+        auto idx = static_cast<std::uint32_t>(id);
+        auto generation = static_cast<std::uint32_t>(id >> 32);
+        if (idx >= _slots.size() || !_slots[idx].alive || _slots[idx].generation != generation) {
+            return nullptr;
+        }
+        return &_slots[idx].track;
+    }
+
+    TrackInfo const *TrackManager::get(TrackId id) const {
+        return const_cast<TrackManager *>(this)->get(id);
+    }
+
+    bool TrackManager::attach(TrackId id, std::string const &key, std::any value) {
+        TrackInfo *track = get(id);
+        if (track == nullptr) {
+            return false;
+        }
+
+        track->attachments[key] = std::move(value);
+        return true;
+    }
+
+    TrackId TrackManager::_create() {
+        std::uint32_t idx;
+        if (_freeSlots.empty()) {
+            idx = _slots.size();
+            _slots.emplace_back();
+        } else {
+            idx = _freeSlots.back();
+            _freeSlots.pop_back();
+        }
+
+        Slot &slot = _slots[idx];
+        slot.alive = true;
+        slot.track = TrackInfo();
+        slot.track.id = (static_cast<TrackId>(slot.generation) << 32) | idx;
+        return slot.track.id;
+    }
+
+    void TrackManager::_kill(TrackId id) {
+        TrackInfo *track = get(id);
+        if (track == nullptr) {
+            return;
+        }
+
+        for (Callback const &callback : _deathCallbacks) {
+            callback(*track);
+        }
+
+        auto idx = static_cast<std::uint32_t>(id);
+        Slot &slot = _slots[idx];
+        slot.alive = false;
+        slot.track.attachments.clear();
+        auto trackerTrack = _trackerTracks.find(slot.trackerId);
+        if (trackerTrack != _trackerTracks.end() && trackerTrack->second == id) {
+            _trackerTracks.erase(trackerTrack);
+        }
+        slot.trackerId = 0;
+        // 0 is skipped, so an id is never 0
+        if (++slot.generation == 0) {
+            slot.generation = 1;
+        }
+        _freeSlots.emplace_back(idx);
+    }
+
+}
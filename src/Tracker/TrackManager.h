@@ -0,0 +1,261 @@
+/**
+ * @file TrackManager.h
+ * @author Люнгрин Андрей aka prostoichelovek <iam.prostoi.chelovek@gmail.com>
+ * @date 19 Oct 2026
+ * @copyright MIT License
+ *
+ * @brief This file contains a manager of persistent face tracks
+ */
+
+#ifndef FACES_TRACKMANAGER_H
+#define FACES_TRACKMANAGER_H
+
+#include <any>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+#include <spdlog/spdlog.h>
+
+#include <Face/Face.h>
+#include <Config/Config.h>
+
+#include "Tracker.hpp"
+
+namespace faces {
+
+    /**
+     * An id of a track: a generation of its slot in the high 32 bits and an index of the slot in the low ones,
+     * so an id of a dead track never matches a new track in the same slot; 0 is never used
+     */
+    using TrackId = std::uint64_t;
+
+    /**
+     * A state of a single track
+     */
+    struct TrackInfo {
+        TrackId id = 0;
+
+        /// a bounding box on the last frame
+        cv::Rect rect;
+
+        /// landmarks on the last frame, relative to the @ref rect
+        std::vector<cv::Point> landmarks;
+
+        /// a label of the track OR -1 if it is unknown
+        int label = -1;
+
+        /// the last descriptor of the face, if some stage has computed it
+        std::vector<double> descriptor;
+
+        /// quality of the face on the last frame
+        FaceQuality quality;
+
+        /// a number of frames passed since the track appeared
+        std::size_t age = 0;
+
+        /// a number of the last frames, where the face was not found; the @ref rect is from the last one it was
+        std::size_t missed = 0;
+
+        /// an id of the lost track, which this one continues (e.g. after an occlusion) OR 0
+        TrackId previousId = 0;
+
+        /// cached results of other stages attached to the track, see TrackManager::attach
+        std::unordered_map<std::string, std::any> attachments;
+    };
+
+    /**
+     * A manager, which stitches frame-to-frame matches of a Tracker into persistent tracks,
+     * so the state of a face (and the results of other stages) survives between the frames. @n
+     * The tracks are stored in a flat array of slots, which are reused after the tracks die;
+     * each slot has a generation, which is a part of the track id, so stale ids are detected. @n
+     * A track, whose face is not matched, is kept for up to `maxMisses` frames (e.g. through a short occlusion
+     * or a missed detection), so it continues if the tracker finds its face again by the id of its own track
+     * (see Tracker::getTrackIds). @n
+     * The birth of a track is reported when it appears, and its death - when it has missed too many frames
+     */
+    class TrackManager {
+    public:
+        using Callback = std::function<void(TrackInfo const &)>;
+
+        /**
+         * @param tracker   - a tracker to match faces with; it is not owned by this class
+         * @param maxMisses - a number of frames a track is kept without its face
+         */
+        explicit TrackManager(Tracker *tracker, std::size_t maxMisses = 5);
+
+        /**
+         * @param tracker - a tracker to match faces with; it is not owned by this class
+         * @param config  - a config with the number of frames a track is kept without its face
+         */
+        TrackManager(Tracker *tracker, Config const &config);
+
+        /**
+         * Matches the given faces to the tracks of the previous frame and updates the tracks. @n
+         * If all of the faces carry ids of alive tracks (e.g. they were returned by @ref predict),
+         * they are matched by the ids; otherwise the tracker is used
+         *
+         * @param faces - faces on the current frame; their Face::trackId are set
+         * @param img   - the current frame; it should not be overwritten until the next call
+         */
+        void update(std::vector<Face> &faces, cv::Mat const &img);
+
+        /**
+         * Updates the tracks by the given matches of the faces of the previous frame to the current ones
+         *
+         * @param faces   - faces on the current frame; their Face::trackId are set
+         * @param matches - pairs of matching face indexes {previousIdx, actualIdx} as returned by Tracker::track
+         * @param img     - the current frame; it should not be overwritten until the next call
+         */
+        void update(std::vector<Face> &faces, std::vector<std::pair<int, int>> const &matches, cv::Mat const &img);
+
+        /**
+         * Predicts the faces of the current tracks on the given frame with Tracker::predict
+         *
+         * @param img - the current frame
+         *
+         * @return predicted faces with ids of their tracks, without the lost ones;
+         *         OR an empty vector if the tracker cannot predict
+         */
+        std::vector<Face> predict(cv::Mat const &img);
+
+        /**
+         * @return a track with the given id OR nullptr if it is dead
+         */
+        TrackInfo *get(TrackId id);
+
+        TrackInfo const *get(TrackId id) const;
+
+        /**
+         * Attaches a value to the track under the given key, replacing the previous one
+         *
+         * @return whether the track is alive
+         */
+        bool attach(TrackId id, std::string const &key, std::any value);
+
+        /**
+         * @return a value attached to the track under the given key
+         *         OR nullptr if there is none, it has a different type or the track is dead
+         */
+        template<typename T>
+        T *getAttachment(TrackId id, std::string const &key) {
+            TrackInfo *track = get(id);
+            if (track == nullptr) {
+                return nullptr;
+            }
+
+            auto it = track->attachments.find(key);
+            return it == track->attachments.end() ? nullptr : std::any_cast<T>(&it->second);
+        }
+
+        /**
+         * Adds a function called with every new track, after its state is filled
+         */
+        void onBirth(Callback callback) {
+            _birthCallbacks.emplace_back(std::move(callback));
+        }
+
+        /**
+         * Adds a function called with every dead track, before its slot is reused
+         */
+        void onDeath(Callback callback) {
+            _deathCallbacks.emplace_back(std::move(callback));
+        }
+
+        /**
+         * @return ids of the tracks in order of the faces on the last frame
+         */
+        [[nodiscard]] std::vector<TrackId> const &getFrameTracks() const {
+            return _frameTracks;
+        }
+
+        /**
+         * @return a number of the frames processed by @ref update
+         */
+        [[nodiscard]] std::size_t getFrameIndex() const {
+            return _frameIndex;
+        }
+
+        /**
+         * @return a number of the tracks with faces on the last frame
+         */
+        [[nodiscard]] std::size_t size() const {
+            return _frameTracks.size();
+        }
+
+        /**
+         * @return ids of the alive tracks, whose faces were not found on the last frame
+         */
+        [[nodiscard]] std::vector<TrackId> const &getMissedTracks() const {
+            return _missedTracks;
+        }
+
+    private:
+        struct Slot {
+            std::uint32_t generation = 1;
+            bool alive = false;
+            TrackInfo track;
+            /// an id of the own track of the tracker, which follows this one, OR 0
+            std::uint64_t trackerId = 0;
+        };
+
+        Tracker *_tracker;
+
+        std::size_t _maxMisses = 5;
+
+        std::vector<Slot> _slots;
+        std::vector<std::uint32_t> _freeSlots;
+
+        /// ids of the tracks of the faces on the last frame
+        std::vector<TrackId> _frameTracks;
+
+        /// ids of the alive tracks without faces on the last frame
+        std::vector<TrackId> _missedTracks;
+
+        /// {an id of the own track of the tracker: an id of the track}
+        std::unordered_map<std::uint64_t, TrackId> _trackerTracks;
+
+        /// the tracks of the last frame in the form expected by the Tracker, without images; reused between frames
+        std::vector<Face> _trackerFaces;
+
+        cv::Mat _prevImg;
+
+        std::size_t _frameIndex = 0;
+
+        std::vector<Callback> _birthCallbacks;
+        std::vector<Callback> _deathCallbacks;
+
+        /**
+         * Updates the tracks by the given matches
+         *
+         * @param trackerIds - ids of the own tracks of the tracker of the faces, see Tracker::getTrackIds,
+         *                     to continue the missed tracks with; may be empty
+         */
+        void _update(std::vector<Face> &faces, std::vector<std::pair<int, int>> const &matches,
+                     std::vector<std::uint64_t> const &trackerIds, cv::Mat const &img);
+
+        /**
+         * Takes a free slot and starts a new track in it
+         *
+         * @return an id of the new track
+         */
+        TrackId _create();
+
+        /**
+         * Reports the death of the track and frees its slot
+         */
+        void _kill(TrackId id);
+
+    };
+
+    FACES_AUGMENT_CONFIG(TrackManager,
+                         FACES_ADD_CONFIG_OPTION("TrackManager.maxMisses", "trackMaxMisses", 5, false,
+                                                 "A number of frames a track is kept without its face "
+                                                 "to be continued if the face is found again")
+    )
+
+}
+
+#endif //FACES_TRACKMANAGER_H
@@ -10,15 +10,21 @@
 #ifndef FACES_TRACKER_HPP
 #define FACES_TRACKER_HPP
 
+#include <optional>
+
 #include <Face/Face.h>
 
 namespace faces {
 
-    // TODO: allow creating non-frame2frame trackers
-    //       i.e. trackers which do not require running detector for every frame
-
     /**
-     * A base class for all of the face trackers
+     * A base class for all of the face trackers. @n
+     * A tracker matches the faces detected on consecutive frames with @ref track. The trackers which
+     * implement @ref _predict do not require running the detector on every frame: on the frames without
+     * detections, the faces are propagated with @ref predict, and @ref track is called only when
+     * the detector runs (see TrackManager::predict). @n
+     * The trackers, which keep the faces, that were not found, for a while (e.g. SortTracker),
+     * also report stable ids of their tracks with @ref getTrackIds, since such a face has no match
+     * on the previous frame when it is found again
      */
     class Tracker {
     public:
@@ -41,7 +47,53 @@ namespace faces {
                 return {};
             }
 
-            return _track(prevFaces, actualFaces, prevImg, actualImg);
+            auto res = _track(prevFaces, actualFaces, prevImg, actualImg);
+            _frameIndexes.reset();
+            return res;
+        }
+
+        /**
+         * Predicts positions of the faces on the current frame without detecting them,
+         * so the detection may be skipped or restricted to the predicted regions. @n
+         * This is a wrapper around the @ref _predict method
+         *
+         * @param prevFaces - a vector of faces on the previous frame
+         * @param prevImg   - a previous image where @p prevFaces were detected or predicted
+         * @param actualImg - a current image
+         *
+         * @return a vector of faces, where i-th one is a prediction of the i-th face of @p prevFaces
+         *         and a face with an empty rect is lost; OR an empty vector if the tracker cannot predict
+         */
+        std::vector<Face> predict(std::vector<Face> const &prevFaces,
+                                  cv::Mat const &prevImg, cv::Mat const &actualImg) {
+            if (!_ok) {
+                return {};
+            }
+
+            auto res = _predict(prevFaces, prevImg, actualImg);
+            _frameIndexes.reset();
+            return res;
+        }
+
+        /**
+         * Tells the tracker the indexes of the frames of the next @ref track or @ref predict call,
+         * so it may reuse the state computed for a frame on the previous calls (e.g. an image pyramid);
+         * the buffers of the frames may be reused for the other frames, so the images cannot tell it
+         *
+         * @param prevIndex   - an index of the previous image
+         * @param actualIndex - an index of the current image
+         */
+        void setFrameIndexes(std::size_t prevIndex, std::size_t actualIndex) {
+            _frameIndexes = {prevIndex, actualIndex};
+        }
+
+        /**
+         * @return ids of the tracks of the faces returned by the last @ref track (i-th id is of the i-th actual face)
+         *         or @ref predict call, which stay the same while the tracker keeps the face, 0 for no track;
+         *         OR an empty vector if the tracker does not keep the identities
+         */
+        [[nodiscard]] std::vector<std::uint64_t> const &getTrackIds() const {
+            return _trackIds;
         }
 
         /**
@@ -55,6 +107,12 @@ namespace faces {
         /// the flag which indicates the readiness of the recognizer
         bool _ok = false;
 
+        /// ids of the tracks of the last faces, see @ref getTrackIds; it should be filled by the implementations
+        std::vector<std::uint64_t> _trackIds;
+
+        /// indexes of the previous and the current frames of the running call, if they are given
+        std::optional<std::pair<std::size_t, std::size_t>> _frameIndexes;
+
         /**
          * Tracks faces frame-to-frame
          *
@@ -70,6 +128,22 @@ namespace faces {
                                                         std::vector<Face> const &actualFaces,
                                                         cv::Mat const &prevImg, cv::Mat const &actualImg) = 0;
 
+        /**
+         * Predicts positions of the faces on the current frame;
+         * the default implementation cannot predict, so it returns an empty vector
+         *
+         * @param prevFaces - a vector of faces on the previous frame
+         * @param prevImg   - a previous image where @p prevFaces were detected or predicted
+         * @param actualImg - a current image
+         *
+         * @return a vector of faces, where i-th one is a prediction of the i-th face of @p prevFaces
+         *         and a face with an empty rect is lost
+         */
+        virtual std::vector<Face> _predict(std::vector<Face> const &prevFaces,
+                                           cv::Mat const &prevImg, cv::Mat const &actualImg) {
+            return {};
+        }
+
     };
 
 }
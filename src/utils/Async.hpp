@@ -0,0 +1,366 @@
+/**
+ * @file Async.hpp
+ * @author Люнгрин Андрей aka prostoichelovek <iam.prostoi.chelovek@gmail.ru>
+ * @date 19 Oct 2026
+ * @copyright MIT License
+ *
+ * @brief This file contains futures with continuations and strands, which run the asynchronous calls
+ *        of the components on the ThreadPool
+ */
+
+#ifndef FACES_ASYNC_HPP
+#define FACES_ASYNC_HPP
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <type_traits>
+#include <variant>
+#include <vector>
+
+#include "ThreadPool.h"
+
+namespace faces {
+
+    template<typename T>
+    class Future;
+
+    template<typename T>
+    class Promise;
+
+    namespace detail {
+
+        template<typename T>
+        struct IsFuture : std::false_type {
+        };
+
+        template<typename T>
+        struct IsFuture<Future<T>> : std::true_type {
+        };
+
+        /// a type of the future returned by a function, which returns the given type
+        template<typename T>
+        struct Unwrapped {
+            using Type = T;
+        };
+
+        template<typename T>
+        struct Unwrapped<Future<T>> {
+            using Type = T;
+        };
+
+        /// a void result is stored as an empty value
+        template<typename T>
+        using Stored = std::conditional_t<std::is_void_v<T>, std::monostate, T>;
+
+        /**
+         * A state shared by a promise and its future
+         */
+        template<typename T>
+        struct SharedState {
+            std::mutex mutex;
+            std::condition_variable readyCondition;
+            bool isReady = false;
+            std::optional<Stored<T>> value;
+            std::exception_ptr error;
+            /// functions to call when the state becomes ready
+            std::vector<std::function<void()>> continuations;
+
+            void complete(std::optional<Stored<T>> result, std::exception_ptr exception) {
+                std::vector<std::function<void()>> toCall;
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    if (isReady) return;
+
+                    value = std::move(result);
+                    error = std::move(exception);
+                    isReady = true;
+                    toCall.swap(continuations);
+                }
+                readyCondition.notify_all();
+
+                for (auto &continuation : toCall) {
+                    continuation();
+                }
+            }
+
+            /**
+             * Calls the function when the state is ready, or right away if it is ready already
+             */
+            void onReady(std::function<void()> function) {
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    if (!isReady) {
+                        continuations.emplace_back(std::move(function));
+                        return;
+                    }
+                }
+                function();
+            }
+        };
+
+        /**
+         * Calls the function and completes the promise with its result or exception;
+         * if the function returns a future, the promise is completed with it when it is ready
+         */
+        template<typename T, typename Function>
+        void fulfil(Promise<T> &promise, Function &function) {
+            using Result = std::invoke_result_t<Function &>;
+            try {
+                if constexpr (IsFuture<Result>::value) {
+                    promise.setFrom(function());
+                } else if constexpr (std::is_void_v<Result>) {
+                    function();
+                    promise.setValue();
+                } else {
+                    promise.setValue(function());
+                }
+            } catch (...) {
+                promise.setError(std::current_exception());
+            }
+        }
+
+    }
+
+    /**
+     * A producer of a value of a Future
+     */
+    template<typename T>
+    class Promise {
+    public:
+        Promise() : _state(std::make_shared<detail::SharedState<T>>()) {}
+
+        [[nodiscard]] Future<T> getFuture() const {
+            return Future<T>(_state);
+        }
+
+        /**
+         * Completes the future with the value; it is ignored if the future is completed already
+         */
+        template<typename... Args>
+        void setValue(Args &&... args) {
+            _state->complete(detail::Stored<T>(std::forward<Args>(args)...), nullptr);
+        }
+
+        /**
+         * Completes the future with the exception, which is rethrown by Future::get
+         */
+        void setError(std::exception_ptr error) {
+            _state->complete(std::nullopt, std::move(error));
+        }
+
+        /**
+         * Completes the future with the result of the other one when it is ready
+         */
+        void setFrom(Future<T> future) {
+            std::shared_ptr<detail::SharedState<T>> other = future._state;
+            if (other == nullptr) {
+                setError(std::make_exception_ptr(std::future_error(std::future_errc::no_state)));
+                return;
+            }
+
+            other->onReady([other, promise = *this]() mutable {
+                promise._state->complete(std::move(other->value), other->error);
+            });
+        }
+
+    private:
+        std::shared_ptr<detail::SharedState<T>> _state;
+
+    };
+
+    /**
+     * A result of an asynchronous call, which may be waited for or chained with other calls by @ref then
+     * without blocking a thread between them. @n
+     * A future has a single consumer: its value is moved out either by @ref get or by the continuation
+     */
+    template<typename T>
+    class Future {
+    public:
+        Future() = default;
+
+        /**
+         * @return whether the future is associated with a promise
+         */
+        [[nodiscard]] bool isValid() const {
+            return _state != nullptr;
+        }
+
+        [[nodiscard]] bool isReady() const {
+            std::lock_guard<std::mutex> lock(_state->mutex);
+            return _state->isReady;
+        }
+
+        /**
+         * Blocks until the future is ready;
+         * it should not be called from a continuation, since it occupies a thread of the pool
+         */
+        void wait() const {
+            std::unique_lock<std::mutex> lock(_state->mutex);
+            _state->readyCondition.wait(lock, [this]() { return _state->isReady; });
+        }
+
+        /**
+         * Waits for the result and takes it
+         *
+         * @return the value of the future
+         *
+         * @throw the exception thrown by the asynchronous call
+         */
+        T get() {
+            wait();
+            if (_state->error) {
+                std::rethrow_exception(_state->error);
+            }
+            if constexpr (!std::is_void_v<T>) {
+                return std::move(*_state->value);
+            }
+        }
+
+        /**
+         * Calls the function with the value on the ThreadPool when the future is ready;
+         * an exception is passed to the returned future without calling the function
+         *
+         * @param function - a function of the value (or without arguments for a void future),
+         *                   which may return a Future itself (e.g. of the next asynchronous call)
+         *
+         * @return a future of the result of the function
+         */
+        template<typename Function>
+        auto then(Function function) {
+            using Result = std::conditional_t<std::is_void_v<T>,
+                    std::invoke_result<Function>, std::invoke_result<Function, T>>;
+            using Next = typename detail::Unwrapped<typename Result::type>::Type;
+
+            Promise<Next> promise;
+            Future<Next> res = promise.getFuture();
+
+            std::shared_ptr<detail::SharedState<T>> state = _state;
+            state->onReady([state, promise, function = std::move(function)]() mutable {
+                ThreadPool::getInstance().post([state, promise, function = std::move(function)]() mutable {
+                    if (state->error) {
+                        promise.setError(state->error);
+                        return;
+                    }
+
+                    auto call = [&state, &function]() {
+                        if constexpr (std::is_void_v<T>) {
+                            return function();
+                        } else {
+                            return function(std::move(*state->value));
+                        }
+                    };
+                    detail::fulfil(promise, call);
+                });
+            });
+
+            return res;
+        }
+
+    private:
+        template<typename>
+        friend class Promise;
+
+        std::shared_ptr<detail::SharedState<T>> _state;
+
+        explicit Future(std::shared_ptr<detail::SharedState<T>> state) : _state(std::move(state)) {}
+
+    };
+
+    /**
+     * Runs the function on the ThreadPool
+     *
+     * @return a future of its result
+     */
+    template<typename Function>
+    auto async(Function function) {
+        using Next = typename detail::Unwrapped<std::invoke_result_t<Function>>::Type;
+
+        Promise<Next> promise;
+        Future<Next> res = promise.getFuture();
+        ThreadPool::getInstance().post([promise, function = std::move(function)]() mutable {
+            detail::fulfil(promise, function);
+        });
+        return res;
+    }
+
+    /**
+     * A sequence of tasks, which run on the ThreadPool one at a time in the order of submission;
+     * it lets the asynchronous calls of a component, which is not thread-safe, run without a dedicated thread
+     * and without occupying the workers of the pool while they wait for each other. @n
+     * The owner of a strand should outlive its tasks
+     */
+    class Strand {
+    public:
+        Strand() = default;
+
+        /**
+         * A copy is a new empty strand, since the tasks belong to the original one
+         */
+        Strand(Strand const &) {}
+
+        Strand &operator=(Strand const &) {
+            return *this;
+        }
+
+        /**
+         * Runs the function after the previous tasks of the strand
+         *
+         * @return a future of its result
+         */
+        template<typename Function>
+        auto run(Function function) {
+            using Next = typename detail::Unwrapped<std::invoke_result_t<Function>>::Type;
+
+            Promise<Next> promise;
+            Future<Next> res = promise.getFuture();
+            post([promise, function = std::move(function)]() mutable {
+                detail::fulfil(promise, function);
+            });
+            return res;
+        }
+
+        /**
+         * Adds the task to the strand; it should not throw
+         */
+        void post(std::function<void()> task) {
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _tasks.emplace_back(std::move(task));
+                if (_isRunning) return;
+                _isRunning = true;
+            }
+            ThreadPool::getInstance().post([this]() { _drain(); });
+        }
+
+    private:
+        std::deque<std::function<void()>> _tasks;
+        /// whether a worker of the pool is running the tasks
+        bool _isRunning = false;
+        std::mutex _mutex;
+
+        void _drain() {
+            while (true) {
+                std::function<void()> task;
+                {
+                    std::lock_guard<std::mutex> lock(_mutex);
+                    if (_tasks.empty()) {
+                        _isRunning = false;
+                        return;
+                    }
+                    task = std::move(_tasks.front());
+                    _tasks.pop_front();
+                }
+                task();
+            }
+        }
+
+    };
+
+}
+
+#endif //FACES_ASYNC_HPP
@@ -0,0 +1,267 @@
+/**
+ * @file BoundedQueue.hpp
+ * @author Люнгрин Андрей aka prostoichelovek <iam.prostoi.chelovek@gmail.ru>
+ * @date 19 Oct 2026
+ * @copyright MIT License
+ *
+ * @brief This file contains a bounded lock-free queue used to pass work between threads
+ */
+
+#ifndef FACES_BOUNDEDQUEUE_HPP
+#define FACES_BOUNDEDQUEUE_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <string>
+#include <thread>
+
+namespace faces {
+
+    /**
+     * What to do with a new item when the queue is full
+     */
+    enum class OverflowPolicy {
+        /// wait until there is a free place
+        Block,
+        /// discard the oldest item in the queue
+        DropOldest,
+        /// discard the new item
+        DropNewest
+    };
+
+    /**
+     * @param name - "block", "dropOldest" or "dropNewest"
+     *
+     * @return a policy with the given name OR std::nullopt if the name is unknown
+     */
+    inline std::optional<OverflowPolicy> getOverflowPolicy(std::string const &name) {
+        if (name == "block") return OverflowPolicy::Block;
+        if (name == "dropOldest") return OverflowPolicy::DropOldest;
+        if (name == "dropNewest") return OverflowPolicy::DropNewest;
+        return std::nullopt;
+    }
+
+    /**
+     * A waiting strategy for the blocking operations on the lock-free structures:
+     * it spins at first, then yields and then sleeps for growing periods, so an idle thread does not burn a core
+     */
+    class Backoff {
+    public:
+        void wait() {
+            if (_step < 16) {
+                // a busy wait
+            } else if (_step < 32) {
+                std::this_thread::yield();
+            } else {
+                std::this_thread::sleep_for(std::chrono::microseconds(50 << (_step - 32) / 8));
+            }
+            if (_step < 64) {
+                ++_step;
+            }
+        }
+
+        void reset() {
+            _step = 0;
+        }
+
+    private:
+        int _step = 0;
+
+    };
+
+    /**
+     * A bounded multi-producer multi-consumer queue without locks by Dmitry Vyukov. @n
+     * Each cell has a sequence number, which tells whether it is ready to be written or read at the given position,
+     * so the producers and the consumers contend only on their own position counter. @n
+     * The capacity is rounded up to a power of two. After the queue is closed, new items are not accepted,
+     * and the blocking @ref pop returns false once the remaining items are taken
+     *
+     * @tparam T - a type of the items; it should be default-constructible and movable
+     */
+    template<typename T>
+    class BoundedQueue {
+    public:
+        explicit BoundedQueue(std::size_t capacity) {
+            std::size_t size = 2;
+            while (size < capacity) {
+                size *= 2;
+            }
+
+            _mask = size - 1;
+            _cells = std::make_unique<Cell[]>(size);
+            for (std::size_t i = 0; i < size; ++i) {
+                _cells[i].sequence.store(i, std::memory_order_relaxed);
+            }
+        }
+
+        BoundedQueue(BoundedQueue const &) = delete;
+
+        BoundedQueue &operator=(BoundedQueue const &) = delete;
+
+        /**
+         * Enqueues the item if there is a free place
+         *
+         * @param value - the item, which is moved from only on success
+         *
+         * @return whether the item was enqueued
+         */
+        bool tryPush(T &value) {
+            Cell *cell;
+            std::size_t pos = _enqueuePos.load(std::memory_order_relaxed);
+            while (true) {
+                cell = &_cells[pos & _mask];
+                std::size_t seq = cell->sequence.load(std::memory_order_acquire);
+                auto diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+                if (diff == 0) {
+                    if (_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                        break;
+                    }
+                } else if (diff < 0) {
+                    return false;
+                } else {
+                    pos = _enqueuePos.load(std::memory_order_relaxed);
+                }
+            }
+
+            cell->data = std::move(value);
+            cell->sequence.store(pos + 1, std::memory_order_release);
+            return true;
+        }
+
+        /**
+         * Dequeues an item if there is one
+         *
+         * @param value - a destination of the item
+         *
+         * @return whether an item was dequeued
+         */
+        bool tryPop(T &value) {
+            Cell *cell;
+            std::size_t pos = _dequeuePos.load(std::memory_order_relaxed);
+            while (true) {
+                cell = &_cells[pos & _mask];
+                std::size_t seq = cell->sequence.load(std::memory_order_acquire);
+                auto diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos + 1);
+                if (diff == 0) {
+                    if (_dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                        break;
+                    }
+                } else if (diff < 0) {
+                    return false;
+                } else {
+                    pos = _dequeuePos.load(std::memory_order_relaxed);
+                }
+            }
+
+            value = std::move(cell->data);
+            cell->sequence.store(pos + _mask + 1, std::memory_order_release);
+            return true;
+        }
+
+        /**
+         * Enqueues the item handling a full queue according to the policy
+         *
+         * @param value  - the item
+         * @param policy - what to do if the queue is full
+         * @param onDrop - a function called with each discarded item,
+         *                 including the new one itself if it was not enqueued
+         *
+         * @return whether the item was enqueued; false if it was dropped or the queue is closed
+         */
+        template<typename OnDrop>
+        bool push(T value, OverflowPolicy policy, OnDrop &&onDrop) {
+            Backoff backoff;
+            while (!isClosed()) {
+                if (tryPush(value)) {
+                    return true;
+                }
+
+                if (policy == OverflowPolicy::DropNewest) {
+                    break;
+                }
+
+                T oldest;
+                if (policy == OverflowPolicy::DropOldest && tryPop(oldest)) {
+                    onDrop(oldest);
+                    continue;
+                }
+
+                backoff.wait();
+            }
+
+            onDrop(value);
+            return false;
+        }
+
+        bool push(T value, OverflowPolicy policy = OverflowPolicy::Block) {
+            return push(std::move(value), policy, [](T &) {});
+        }
+
+        /**
+         * Dequeues an item waiting for it if the queue is empty
+         *
+         * @param value - a destination of the item
+         *
+         * @return whether an item was dequeued; false if the queue is closed and empty
+         */
+        bool pop(T &value) {
+            Backoff backoff;
+            while (!tryPop(value)) {
+                // an item may have been pushed right before closing
+                if (isClosed()) {
+                    return tryPop(value);
+                }
+
+                backoff.wait();
+            }
+            return true;
+        }
+
+        /**
+         * Stops accepting new items; it should be called after all of the producers have stopped
+         */
+        void close() {
+            _closed.store(true, std::memory_order_release);
+        }
+
+        [[nodiscard]] bool isClosed() const {
+            return _closed.load(std::memory_order_acquire);
+        }
+
+        /**
+         * @return an approximate number of the items in the queue
+         */
+        [[nodiscard]] std::size_t size() const {
+            std::size_t enqueued = _enqueuePos.load(std::memory_order_relaxed);
+            std::size_t dequeued = _dequeuePos.load(std::memory_order_relaxed);
+            return enqueued > dequeued ? enqueued - dequeued : 0;
+        }
+
+        [[nodiscard]] std::size_t capacity() const {
+            return _mask + 1;
+        }
+
+    private:
+        struct Cell {
+            std::atomic<std::size_t> sequence;
+            T data;
+        };
+
+        // the positions are on separate cache lines, so the producers and the consumers do not share them
+        static constexpr std::size_t _cacheLineSize = 64;
+
+        std::unique_ptr<Cell[]> _cells;
+        std::size_t _mask;
+
+        alignas(_cacheLineSize) std::atomic<std::size_t> _enqueuePos = 0;
+        alignas(_cacheLineSize) std::atomic<std::size_t> _dequeuePos = 0;
+        alignas(_cacheLineSize) std::atomic<bool> _closed = false;
+
+    };
+
+}
+
+#endif //FACES_BOUNDEDQUEUE_HPP
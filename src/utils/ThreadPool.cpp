@@ -0,0 +1,271 @@
+/**
+ * @file ThreadPool.cpp
+ * @author Люнгрин Андрей aka prostoichelovek <iam.prostoi.chelovek@gmail.ru>
+ * @date 19 Oct 2026
+ * @copyright MIT License
+ */
+
+#include "ThreadPool.h"
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include <opencv2/core/utility.hpp>
+
+#include "BoundedQueue.hpp"
+
+namespace faces {
+
+    thread_local int ThreadPool::_workerIdx = -1;
+    thread_local ThreadPool const *ThreadPool::_workerPool = nullptr;
+
+    std::vector<int> parseCpuList(std::string const &list) {
+        std::vector<int> res;
+
+        std::stringstream stream(list);
+        std::string range;
+        while (std::getline(stream, range, ',')) {
+            if (range.empty()) continue;
+
+            try {
+                std::size_t dash = range.find('-');
+                int first = std::stoi(range.substr(0, dash));
+                int last = dash == std::string::npos ? first : std::stoi(range.substr(dash + 1));
+                if (first < 0 || last < first) {
+                    return {};
+                }
+                for (int cpu = first; cpu <= last; ++cpu) {
+                    res.emplace_back(cpu);
+                }
+            } catch (std::logic_error &e) {
+                return {};
+            }
+        }
+
+        return res;
+    }
+
+    std::vector<int> getNumaNodeCpus(int node) {
+        std::ifstream file("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+        std::string list;
+        if (!file || !std::getline(file, list)) {
+            return {};
+        }
+        return parseCpuList(list);
+    }
+
+    bool setThreadAffinity(std::vector<int> const &cpus) {
+        if (cpus.empty()) {
+            return false;
+        }
+
+#ifdef __linux__
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        for (int cpu : cpus) {
+            if (cpu < CPU_SETSIZE) {
+                CPU_SET(cpu, &set);
+            }
+        }
+        return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+        return false;
+#endif
+    }
+
+    ThreadPool &ThreadPool::getInstance() {
+        static ThreadPool instance = []() {
+            Config const &config = Config::getInstance();
+
+            int threads = 0;
+            int opencvThreads = 1;
+            std::vector<int> cpus;
+            try {
+                threads = config["ThreadPool.threads"].getInt();
+                opencvThreads = config["ThreadPool.opencvThreads"].getInt();
+                cpus = parseCpuList(config["ThreadPool.cpus"].getString());
+                int numaNode = config["ThreadPool.numaNode"].getInt();
+                if (cpus.empty() && numaNode >= 0) {
+                    cpus = getNumaNodeCpus(numaNode);
+                    if (cpus.empty()) {
+                        spdlog::error("Cannot get CPUs of the NUMA node {}, the threads are not pinned", numaNode);
+                    }
+                }
+            } catch (std::out_of_range &e) {
+                spdlog::error("Cannot get parameters of the ThreadPool from the config, using the default ones");
+            }
+            if (threads <= 0) {
+                threads = static_cast<int>(cpus.empty() ? std::max(1u, std::thread::hardware_concurrency())
+                                                        : cpus.size());
+            }
+
+            // OpenCV runs its parallel regions on the calling thread and opencvThreads - 1 of its own,
+            // which are taken from the budget, so the pool keeps at least a single worker
+            opencvThreads = std::clamp(opencvThreads, 1, threads);
+            cv::setNumThreads(opencvThreads);
+            threads = std::max(1, threads - (opencvThreads - 1));
+
+            return ThreadPool(threads, cpus);
+        }();
+        return instance;
+    }
+
+    ThreadPool::ThreadPool(std::size_t threads, std::vector<int> cpus) {
+        if (threads == 0) {
+            threads = std::max(1u, std::thread::hardware_concurrency());
+        }
+
+        for (std::size_t i = 0; i < threads; ++i) {
+            _queues.emplace_back(std::make_unique<WorkerQueue>());
+        }
+        for (std::size_t i = 0; i < threads; ++i) {
+            _workers.emplace_back(&ThreadPool::_run, this, i, cpus);
+        }
+    }
+
+    ThreadPool::~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(_sleepMutex);
+            _isStopping = true;
+        }
+        _wakeUp.notify_all();
+
+        for (std::thread &worker : _workers) {
+            worker.join();
+        }
+    }
+
+    void ThreadPool::parallel(std::size_t count, std::function<void(std::size_t)> const &function) {
+        if (count == 0) {
+            return;
+        }
+        if (count == 1 || _workers.empty()) {
+            for (std::size_t i = 0; i < count; ++i) {
+                function(i);
+            }
+            return;
+        }
+
+        // the state outlives the call, since the tasks, which were not claimed, may start after it returns
+        struct State {
+            std::unique_ptr<std::atomic<bool>[]> isClaimed;
+            std::atomic<std::size_t> doneCount = 0;
+            std::exception_ptr error;
+            std::mutex errorMutex;
+        };
+        auto state = std::make_shared<State>();
+        state->isClaimed = std::make_unique<std::atomic<bool>[]>(count);
+
+        auto call = [state, &function](std::size_t i) {
+            if (state->isClaimed[i].exchange(true)) {
+                return;
+            }
+
+            try {
+                function(i);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(state->errorMutex);
+                if (!state->error) {
+                    state->error = std::current_exception();
+                }
+            }
+            ++state->doneCount;
+        };
+
+        for (std::size_t i = 1; i < count; ++i) {
+            _push([call, i]() { call(i); });
+        }
+        for (std::size_t i = 0; i < count; ++i) {
+            call(i);
+        }
+
+        Backoff backoff;
+        while (state->doneCount < count) {
+            backoff.wait();
+        }
+
+        if (state->error) {
+            std::rethrow_exception(state->error);
+        }
+    }
+
+    void ThreadPool::parallelFor(std::size_t begin, std::size_t end,
+                                 std::function<void(std::size_t)> const &function) {
+        if (begin >= end) {
+            return;
+        }
+
+        std::atomic<std::size_t> next = begin;
+        std::size_t count = std::min(end - begin, getThreadsCount() + 1);
+        parallel(count, [&next, end, &function](std::size_t) {
+            for (std::size_t i = next++; i < end; i = next++) {
+                function(i);
+            }
+        });
+    }
+
+    void ThreadPool::_push(Task task) {
+        std::size_t idx = _workerPool == this ? _workerIdx : _nextQueue++ % _queues.size();
+        {
+            std::lock_guard<std::mutex> lock(_queues[idx]->mutex);
+            _queues[idx]->tasks.emplace_back(std::move(task));
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(_sleepMutex);
+            ++_pendingCount;
+        }
+        _wakeUp.notify_one();
+    }
+
+    bool ThreadPool::_take(std::size_t worker, Task &task) {
+        for (std::size_t i = 0; i < _queues.size(); ++i) {
+            WorkerQueue &queue = *_queues[(worker + i) % _queues.size()];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            if (queue.tasks.empty()) continue;
+
+            // the own newest task is likely to be in the cache, and the oldest ones are stolen
+            if (i == 0) {
+                task = std::move(queue.tasks.back());
+                queue.tasks.pop_back();
+            } else {
+                task = std::move(queue.tasks.front());
+                queue.tasks.pop_front();
+            }
+            --_pendingCount;
+            return true;
+        }
+        return false;
+    }
+
+    void ThreadPool::_run(std::size_t worker, std::vector<int> const &cpus) {
+        _workerIdx = static_cast<int>(worker);
+        _workerPool = this;
+
+        if (!cpus.empty() && !setThreadAffinity(cpus)) {
+            spdlog::warn("Cannot pin a worker of the thread pool to the CPUs");
+        }
+
+        Task task;
+        while (true) {
+            if (_take(worker, task)) {
+                task();
+                task = nullptr;
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(_sleepMutex);
+            _wakeUp.wait(lock, [this]() { return _pendingCount > 0 || _isStopping; });
+            if (_isStopping && _pendingCount == 0) {
+                break;
+            }
+        }
+    }
+
+}
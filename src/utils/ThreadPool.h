@@ -0,0 +1,184 @@
+/**
+ * @file ThreadPool.h
+ * @author Люнгрин Андрей aka prostoichelovek <iam.prostoi.chelovek@gmail.ru>
+ * @date 19 Oct 2026
+ * @copyright MIT License
+ *
+ * @brief This file contains a library-wide work-stealing thread pool and helpers to pin threads to CPUs
+ */
+
+#ifndef FACES_THREADPOOL_H
+#define FACES_THREADPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <spdlog/spdlog.h>
+
+#include <Config/Config.h>
+
+namespace faces {
+
+    /**
+     * Parses a list of CPUs in the Linux format, e.g. "0-3,8,10-11"
+     *
+     * @return indexes of the CPUs OR an empty vector if the list is empty or malformed
+     */
+    std::vector<int> parseCpuList(std::string const &list);
+
+    /**
+     * @return indexes of the CPUs of the given NUMA node OR an empty vector if they are unknown (e.g. not on Linux)
+     */
+    std::vector<int> getNumaNodeCpus(int node);
+
+    /**
+     * Pins the calling thread to the given CPUs; it is supported only on Linux
+     *
+     * @return whether the thread was pinned
+     */
+    bool setThreadAffinity(std::vector<int> const &cpus);
+
+    /**
+     * A library-wide pool of threads, which the parallel paths of the components run on,
+     * so several pipelines in the same process share a single thread budget instead of sizing
+     * themselves to the machine independently. @n
+     * Each worker has its own queue of tasks: a task submitted from a worker goes to its own queue,
+     * and the others are spread over the queues in turn. A worker takes the newest task of its own queue,
+     * and an idle one steals the oldest task of the others. @n
+     * The pool is created on the first use with the budget from the config;
+     * its workers may be pinned to a NUMA node or to a list of CPUs. @n
+     * The budget (`ThreadPool.threads`) is shared with OpenCV: its number of threads (`ThreadPool.opencvThreads`)
+     * is set once, when the library-wide pool is created, and the pool gets the rest of the budget.
+     * OpenCV counts the calling thread in it, so its parallel regions add `opencvThreads - 1` threads,
+     * and the default of 1 runs them serially on the caller. The setting is process-wide,
+     * so the workers themselves do not change it
+     */
+    class ThreadPool {
+    public:
+        /**
+         * @return the library-wide pool, creating it if necessary
+         */
+        static ThreadPool &getInstance();
+
+        /**
+         * Starts the workers
+         *
+         * @param threads - a number of the workers; 0 to use one per core
+         * @param cpus    - CPUs to pin the workers to OR an empty vector to not pin them
+         */
+        explicit ThreadPool(std::size_t threads, std::vector<int> cpus = {});
+
+        /**
+         * Finishes the tasks already submitted and stops the workers
+         */
+        ~ThreadPool();
+
+        ThreadPool(ThreadPool const &) = delete;
+
+        ThreadPool &operator=(ThreadPool const &) = delete;
+
+        /**
+         * Runs the function on the pool
+         *
+         * @return a future of the result of the function
+         */
+        template<typename Function>
+        auto submit(Function function) -> std::future<decltype(function())> {
+            using Result = decltype(function());
+            auto task = std::make_shared<std::packaged_task<Result()>>(std::move(function));
+            std::future<Result> res = task->get_future();
+            _push([task]() { (*task)(); });
+            return res;
+        }
+
+        /**
+         * Runs the function on the pool without a way to wait for it; the function should not throw
+         */
+        void post(std::function<void()> function) {
+            _push(std::move(function));
+        }
+
+        /**
+         * Runs the function `count` times possibly in parallel and waits for all of the calls;
+         * the calling thread runs the calls, which are not taken by the workers yet, itself,
+         * so it may be called from a worker of the pool without a deadlock
+         *
+         * @param count    - a number of the calls
+         * @param function - a function called with an index of the call from 0 to @p count
+         */
+        void parallel(std::size_t count, std::function<void(std::size_t)> const &function);
+
+        /**
+         * Calls the function for each index of the range, distributing them over the workers
+         *
+         * @see parallel
+         */
+        void parallelFor(std::size_t begin, std::size_t end, std::function<void(std::size_t)> const &function);
+
+        [[nodiscard]] std::size_t getThreadsCount() const {
+            return _workers.size();
+        }
+
+    private:
+        using Task = std::function<void()>;
+
+        /**
+         * A queue of a single worker
+         */
+        struct WorkerQueue {
+            std::deque<Task> tasks;
+            std::mutex mutex;
+        };
+
+        std::vector<std::unique_ptr<WorkerQueue>> _queues;
+        std::vector<std::thread> _workers;
+
+        /// a number of the submitted tasks, which are not taken yet
+        std::atomic<std::size_t> _pendingCount = 0;
+        std::atomic<std::size_t> _nextQueue = 0;
+        bool _isStopping = false;
+
+        std::mutex _sleepMutex;
+        std::condition_variable _wakeUp;
+
+        /// an index of the worker of this pool running on the current thread OR -1
+        static thread_local int _workerIdx;
+        static thread_local ThreadPool const *_workerPool;
+
+        void _push(Task task);
+
+        /**
+         * Takes a task from the own queue of the worker OR steals one from the others
+         */
+        bool _take(std::size_t worker, Task &task);
+
+        void _run(std::size_t worker, std::vector<int> const &cpus);
+
+    };
+
+    FACES_AUGMENT_CONFIG(ThreadPool,
+                         FACES_ADD_CONFIG_OPTION("ThreadPool.threads", "threads", 0, false,
+                                                 "A number of threads of the library, including the ones of OpenCV; "
+                                                 "0 to use one per core")
+                                 FACES_ADD_CONFIG_OPTION("ThreadPool.opencvThreads", "opencvThreads", 1, false,
+                                                         "A number of threads of the parallel regions of OpenCV "
+                                                         "out of the threads of the library, including the caller; "
+                                                         "1 to run them serially")
+                                 FACES_ADD_CONFIG_OPTION("ThreadPool.cpus", "cpus", "", false,
+                                                         "CPUs to pin the threads of the pool to, e.g. 0-3,8")
+                                 FACES_ADD_CONFIG_OPTION("ThreadPool.numaNode", "numaNode", -1, false,
+                                                         "A NUMA node to pin the threads of the pool to "
+                                                         "if the CPUs are not given; -1 to not pin them")
+    )
+
+}
+
+#endif //FACES_THREADPOOL_H
@@ -0,0 +1,158 @@
+/**
+ * @file assignment.cpp
+ * @author Люнгрин Андрей aka prostoichelovek <iam.prostoi.chelovek@gmail.ru>
+ * @date 19 Oct 2026
+ * @copyright MIT License
+ */
+
+#include "assignment.h"
+
+#include <limits>
+#include <numeric>
+
+namespace faces {
+
+    namespace {
+
+        /**
+         * Solves a dense assignment problem with n <= m
+         *
+         * @param cost - a row-major n x m matrix
+         *
+         * @return a column assigned to each of the rows
+         */
+        std::vector<int> solveDense(std::vector<double> const &cost, std::size_t n, std::size_t m) {
+            double const inf = std::numeric_limits<double>::infinity();
+
+            // 1-based potentials and matching; p[j] is a row matched to the j-th column, 0 is a fictive row
+            std::vector<double> u(n + 1, 0), v(m + 1, 0), minv(m + 1);
+            std::vector<std::size_t> p(m + 1, 0), way(m + 1, 0);
+            std::vector<char> used(m + 1);
+
+            for (std::size_t i = 1; i <= n; ++i) {
+                p[0] = i;
+                std::size_t j0 = 0;
+                std::fill(minv.begin(), minv.end(), inf);
+                std::fill(used.begin(), used.end(), false);
+
+                do {
+                    used[j0] = true;
+                    std::size_t i0 = p[j0], j1 = 0;
+                    double delta = inf;
+                    for (std::size_t j = 1; j <= m; ++j) {
+                        if (used[j]) continue;
+
+                        double cur = cost[(i0 - 1) * m + j - 1] - u[i0] - v[j];
+                        if (cur < minv[j]) {
+                            minv[j] = cur;
+                            way[j] = j0;
+                        }
+                        if (minv[j] < delta) {
+                            delta = minv[j];
+                            j1 = j;
+                        }
+                    }
+                    for (std::size_t j = 0; j <= m; ++j) {
+                        if (used[j]) {
+                            u[p[j]] += delta;
+                            v[j] -= delta;
+                        } else {
+                            minv[j] -= delta;
+                        }
+                    }
+                    j0 = j1;
+                } while (p[j0] != 0);
+
+                do {
+                    std::size_t j1 = way[j0];
+                    p[j0] = p[j1];
+                    j0 = j1;
+                } while (j0 != 0);
+            }
+
+            std::vector<int> res(n, -1);
+            for (std::size_t j = 1; j <= m; ++j) {
+                if (p[j] != 0) {
+                    res[p[j] - 1] = static_cast<int>(j - 1);
+                }
+            }
+            return res;
+        }
+
+        std::size_t findRoot(std::vector<std::size_t> &parents, std::size_t x) {
+            while (parents[x] != x) {
+                parents[x] = parents[parents[x]];
+                x = parents[x];
+            }
+            return x;
+        }
+
+    }
+
+    std::vector<int> solveAssignment(std::vector<double> const &cost, std::size_t rows, std::size_t cols,
+                                     double maxCost) {
+        std::vector<int> res(rows, -1);
+
+        // Connected components ->
+        // rows are the nodes [0, rows), columns are [rows, rows + cols)
+        std::vector<std::size_t> parents(rows + cols);
+        std::iota(parents.begin(), parents.end(), 0);
+        std::vector<char> hasPairs(rows + cols, false);
+        for (std::size_t i = 0; i < rows; ++i) {
+            for (std::size_t j = 0; j < cols; ++j) {
+                if (cost[i * cols + j] >= maxCost) continue;
+
+                hasPairs[i] = hasPairs[rows + j] = true;
+                parents[findRoot(parents, i)] = findRoot(parents, rows + j);
+            }
+        }
+
+        std::vector<std::vector<std::size_t>> componentRows(rows + cols), componentCols(rows + cols);
+        for (std::size_t i = 0; i < rows; ++i) {
+            if (hasPairs[i]) componentRows[findRoot(parents, i)].emplace_back(i);
+        }
+        for (std::size_t j = 0; j < cols; ++j) {
+            if (hasPairs[rows + j]) componentCols[findRoot(parents, rows + j)].emplace_back(j);
+        }
+        // <- Connected components
+
+        // forbidden pairs get a cost larger than any sum of the allowed ones, so they are chosen only if forced
+        double forbiddenCost = maxCost * static_cast<double>(rows + cols + 1) + 1;
+
+        std::vector<double> denseCost;
+        for (std::size_t c = 0; c < rows + cols; ++c) {
+            std::vector<std::size_t> const &rowIdxs = componentRows[c];
+            std::vector<std::size_t> const &colIdxs = componentCols[c];
+            if (rowIdxs.empty()) continue;
+
+            // the dense solver requires the rows not to outnumber the columns
+            bool transposed = rowIdxs.size() > colIdxs.size();
+            std::vector<std::size_t> const &denseRows = transposed ? colIdxs : rowIdxs;
+            std::vector<std::size_t> const &denseCols = transposed ? rowIdxs : colIdxs;
+
+            denseCost.resize(denseRows.size() * denseCols.size());
+            for (std::size_t i = 0; i < denseRows.size(); ++i) {
+                for (std::size_t j = 0; j < denseCols.size(); ++j) {
+                    double value = transposed ? cost[denseCols[j] * cols + denseRows[i]]
+                                              : cost[denseRows[i] * cols + denseCols[j]];
+                    denseCost[i * denseCols.size() + j] = value < maxCost ? value : forbiddenCost;
+                }
+            }
+
+            std::vector<int> denseRes = solveDense(denseCost, denseRows.size(), denseCols.size());
+            for (std::size_t i = 0; i < denseRows.size(); ++i) {
+                std::size_t j = denseRes[i];
+                if (denseCost[i * denseCols.size() + j] >= maxCost) continue;
+
+                if (transposed) {
+                    res[denseCols[j]] = static_cast<int>(denseRows[i]);
+                } else {
+                    res[denseRows[i]] = static_cast<int>(denseCols[j]);
+                }
+            }
+        }
+
+        return res;
+    }
+
+}
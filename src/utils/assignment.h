@@ -0,0 +1,37 @@
+/**
+ * @file assignment.h
+ * @author Люнгрин Андрей aka prostoichelovek <iam.prostoi.chelovek@gmail.ru>
+ * @date 19 Oct 2026
+ * @copyright MIT License
+ *
+ * @brief This file contains a solver of the linear assignment problem used to match objects between frames
+ */
+
+#ifndef FACES_ASSIGNMENT_H
+#define FACES_ASSIGNMENT_H
+
+#include <cstddef>
+#include <vector>
+
+namespace faces {
+
+    /**
+     * Finds an assignment of rows to columns with the minimal total cost. @n
+     * Pairs with the cost not less than @p maxCost are never assigned, so the rows and columns
+     * are split into independent groups connected by the allowed pairs, and each group is solved separately
+     * with the Hungarian (Kuhn-Munkres with potentials, as in Jonker-Volgenant) algorithm,
+     * which is cubic only in the size of the group
+     *
+     * @param cost    - a row-major matrix of the costs of assigning the i-th row to the j-th column
+     * @param rows    - a number of rows of the matrix
+     * @param cols    - a number of columns of the matrix
+     * @param maxCost - a cost of the forbidden pairs
+     *
+     * @return a column assigned to each of the rows OR -1 if a row is not assigned
+     */
+    std::vector<int> solveAssignment(std::vector<double> const &cost, std::size_t rows, std::size_t cols,
+                                     double maxCost);
+
+}
+
+#endif //FACES_ASSIGNMENT_H
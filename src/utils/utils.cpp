@@ -27,4 +27,10 @@ namespace faces {
         return sqrt(pow(b.x - a.x, 2) + pow(b.y - a.y, 2));
     }
 
+    double getIou(cv::Rect2d const &a, cv::Rect2d const &b) {
+        double intersection = (a & b).area();
+        double unionArea = a.area() + b.area() - intersection;
+        return unionArea > 0 ? intersection / unionArea : 0;
+    }
+
 }
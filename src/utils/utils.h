@@ -88,6 +88,11 @@ namespace faces {
      */
     double getDist(cv::Point const &a, cv::Point const &b);
 
+    /**
+     * @return an intersection over union of the given rectangles in range [0, 1]
+     */
+    double getIou(cv::Rect2d const &a, cv::Rect2d const &b);
+
 }
 
 #endif //FACES_UTILS_H
@@ -0,0 +1,104 @@
+/**
+ * @file galleryConverter.cpp
+ * @author Люнгрин Андрей aka prostoichelovek <iam.prostoi.chelovek@gmail.ru>
+ * @date 19 Oct 2026
+ * @copyright MIT License
+ *
+ * @brief This file contains a tool, which converts classifiers.dat and descriptor samples into a gallery file
+ *
+ * Usage: faces_gallery_converter <output gallery> <input>...
+ *  - `*.dat` inputs are files of DlibSvmClassifier; their support vectors are extracted as gallery descriptors,
+ *    a label of each vector is determined by the sign of its weight in the pairwise decision function;
+ *  - `*.csv` inputs contain whitespace-separated descriptors, one per line;
+ *    their label is the name of the file (e.g. data/samples/1.csv has a label 1)
+ */
+
+#include <set>
+#include <sstream>
+#include <iterator>
+#include <fstream>
+#include <filesystem>
+
+#include <spdlog/spdlog.h>
+
+#include <Gallery/GalleryFile.h>
+#include <Recognizer/Implementations/Descriptors/DlibSvmClassifier.h>
+
+using Samples = std::set<std::pair<int, std::vector<double>>>;
+
+bool readClassifiers(std::string const &path, Samples &samples) {
+    std::vector<faces::dlibSvm::SingleSvmClassifier> classifiers;
+    try {
+        dlib::deserialize(path) >> classifiers;
+    } catch (dlib::serialization_error &e) {
+        spdlog::error("Cannot load descriptor classifiers from {}: {}", path, e.what());
+        return false;
+    }
+
+    for (auto const &classifier : classifiers) {
+        auto const &function = classifier.classifier;
+        for (long i = 0; i < function.basis_vectors.size(); ++i) {
+            int label = function.alpha(i) < 0 ? classifier.negativeLabel : classifier.positiveLabel;
+            auto const &basisVector = function.basis_vectors(i);
+            samples.emplace(label, std::vector<double>(basisVector.begin(), basisVector.end()));
+        }
+    }
+    return true;
+}
+
+bool readSamples(std::filesystem::path const &path, Samples &samples) {
+    int label;
+    try {
+        label = std::stoi(path.stem().string());
+    } catch (std::logic_error &e) {
+        spdlog::warn("Skipping samples {}: the file name is not a label", path.string());
+        return true;
+    }
+
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        spdlog::error("Cannot open samples {}", path.string());
+        return false;
+    }
+
+    std::string line;
+    while (std::getline(file, line)) {
+        std::istringstream iss(line);
+        std::vector<double> descriptor{std::istream_iterator<double>(iss), std::istream_iterator<double>()};
+        if (!descriptor.empty()) {
+            samples.emplace(label, std::move(descriptor));
+        }
+    }
+    return true;
+}
+
+int main(int argc, char **argv) {
+    if (argc < 3) {
+        spdlog::error("Usage: {} <output gallery> <classifiers.dat | samples.csv>...", argv[0]);
+        return 1;
+    }
+
+    Samples samples;
+    for (int i = 2; i < argc; ++i) {
+        std::filesystem::path input(argv[i]);
+        bool ok = input.extension() == ".dat" ? readClassifiers(input.string(), samples)
+                                              : readSamples(input, samples);
+        if (!ok) {
+            return 1;
+        }
+    }
+
+    std::vector<int> labels;
+    std::vector<std::vector<double>> descriptors;
+    for (auto const &[label, descriptor] : samples) {
+        labels.emplace_back(label);
+        descriptors.emplace_back(descriptor);
+    }
+
+    if (!faces::saveGallery(argv[1], labels, descriptors)) {
+        return 1;
+    }
+    spdlog::info("Saved {} descriptors to {}", descriptors.size(), argv[1]);
+
+    return 0;
+}
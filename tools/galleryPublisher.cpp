@@ -0,0 +1,71 @@
+/**
+ * @file galleryPublisher.cpp
+ * @author Люнгрин Андрей aka prostoichelovek <iam.prostoi.chelovek@gmail.ru>
+ * @date 19 Oct 2026
+ * @copyright MIT License
+ *
+ * @brief This file contains a tool, which publishes a gallery file into the shared memory
+ *
+ * Usage: faces_gallery_publisher <shared name> <gallery file> [watch interval in seconds]
+ *
+ * Worker processes attach to the published gallery with GalleryClassifier ('GalleryClassifier.sharedName'),
+ * so the gallery is kept in memory once regardless of the number of workers.
+ * If the watch interval is given, the file is republished as a new generation whenever it changes
+ */
+
+#include <thread>
+#include <fstream>
+#include <iterator>
+#include <filesystem>
+
+#include <spdlog/spdlog.h>
+
+#include <Gallery/GalleryFile.h>
+#include <Gallery/SharedGallery.h>
+
+bool publishFile(faces::SharedGalleryPublisher &publisher, std::string const &path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        spdlog::error("Cannot open a gallery {}", path);
+        return false;
+    }
+    std::vector<char> data{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+
+    // do not publish a broken gallery, so the workers would keep the previous one
+    faces::MappedGallery gallery;
+    if (!gallery.assign(data) || !gallery.validate()) {
+        return false;
+    }
+
+    return publisher.publish(data);
+}
+
+int main(int argc, char **argv) {
+    if (argc < 3) {
+        spdlog::error("Usage: {} <shared name> <gallery file> [watch interval in seconds]", argv[0]);
+        return 1;
+    }
+
+    std::string const path = argv[2];
+    faces::SharedGalleryPublisher publisher(argv[1]);
+    if (!publisher.isOk() || !publishFile(publisher, path)) {
+        return 1;
+    }
+
+    if (argc < 4) {
+        return 0;
+    }
+
+    std::chrono::seconds interval(std::stoi(argv[3]));
+    auto lastWrite = std::filesystem::last_write_time(path);
+    while (true) {
+        std::this_thread::sleep_for(interval);
+
+        std::error_code error;
+        auto writeTime = std::filesystem::last_write_time(path, error);
+        if (!error && writeTime != lastWrite) {
+            lastWrite = writeTime;
+            publishFile(publisher, path);
+        }
+    }
+}